@@ -0,0 +1,39 @@
+#!/bin/sh
+# Scaling events on a feasible ring must not kill anyone.
+# Starts a ring, adds and removes philosophers through the control FIFO,
+# and reports the scaling events, throughput and deaths of each run.
+#
+# usage: bench/elastic.sh [runs] [philos time_to_die time_to_eat time_to_sleep]
+
+PHILO=${PHILO:-./philo}
+RUNS=${1:-4}
+[ $# -gt 0 ] && shift
+ARGS=${*:-"4 800 200 200"}
+FIFO=$(mktemp -u /tmp/philo_ctl.XXXXXX)
+LOG=$(mktemp /tmp/philo_log.XXXXXX)
+deaths=0
+
+send() {
+	timeout 1 sh -c "echo '$1' > '$FIFO'"
+}
+
+i=0
+while [ $i -lt "$RUNS" ]; do
+	# shellcheck disable=SC2086
+	timeout 5 "$PHILO" $ARGS --control="$FIFO" --stats >"$LOG" 2>"$LOG.err" &
+	pid=$!
+	sleep 0.5; send "add 1"
+	sleep 0.7; send "add 3"
+	sleep 0.7; send "remove 2"
+	sleep 0.7; send "remove 5"
+	wait $pid
+	if grep -q died "$LOG"; then
+		deaths=$((deaths + 1))
+		grep died "$LOG"
+	fi
+	cat "$LOG.err"
+	i=$((i + 1))
+done
+rm -f "$FIFO" "$LOG" "$LOG.err"
+echo "runs $RUNS deaths $deaths"
+[ "$deaths" -eq 0 ]
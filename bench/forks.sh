@@ -0,0 +1,34 @@
+#!/bin/sh
+# Mutex forks against the lock-free bitmap engine (--forks=bitmap):
+# meal throughput and the time philosophers waited for their forks
+# (median, p99 and worst case, from --stats), averaged over the runs,
+# plus the number of runs in which someone died.
+#
+# usage: bench/forks.sh [runs] [sizes...]
+
+PHILO=${PHILO:-./philo}
+RUNS=${1:-5}
+[ $# -gt 0 ] && shift
+SIZES=${*:-"4 5 64 200"}
+
+printf '%6s %7s %14s %10s %10s %10s %7s\n' "N" "forks" "meals_per_sec" \
+	"p50_us" "p99_us" "max_us" "deaths"
+for n in $SIZES; do
+	for engine in mutex bitmap; do
+		i=0
+		while [ $i -lt "$RUNS" ]; do
+			timeout 30 "$PHILO" "$n" 800 200 200 10 --forks=$engine \
+				--stats 2>&1
+			i=$((i + 1))
+		done | awk -v n="$n" -v e="$engine" -v runs="$RUNS" '
+			/^meals_per_sec/ { mps += $2 }
+			/^wait_p50_us/ { p50 += $2 }
+			/^wait_p99_us/ { p99 += $2 }
+			/^wait_max_us/ { max += $2 }
+			/ died$/ { deaths++ }
+			END {
+				printf "%6d %7s %14d %10d %10d %10d %7d\n", n, e,
+					mps / runs, p50 / runs, p99 / runs, max / runs, deaths
+			}'
+	done
+done
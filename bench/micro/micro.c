@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   micro.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:58 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:58 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "micro.h"
+
+/**
+ * @brief Read the monotonic clock in nanoseconds.
+ *
+ * @return The current monotonic time, in nanoseconds.
+ */
+long	micro_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+#ifdef __linux__
+# include <sys/syscall.h>
+
+/**
+ * @brief Pin the calling thread to one CPU.
+ *
+ * The CPU index wraps around the number of online CPUs, so on a single
+ * CPU every thread shares CPU 0.
+ *
+ * @param cpu Index of the CPU to run on.
+ */
+void	micro_pin(int cpu)
+{
+	unsigned long	mask;
+	long			cpus;
+
+	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cpus < 1)
+		cpus = 1;
+	mask = 1UL << (cpu % cpus % WORD_BITS);
+	syscall(SYS_sched_setaffinity, 0, sizeof(mask), &mask);
+}
+
+#else
+
+/**
+ * @brief Thread pinning is only available on Linux.
+ *
+ * @param cpu Index of the CPU to run on, unused.
+ */
+void	micro_pin(int cpu)
+{
+	(void)cpu;
+}
+
+#endif
+
+/**
+ * @brief Order two samples for qsort.
+ *
+ * @param a Pointer to the first sample.
+ * @param b Pointer to the second sample.
+ * @return Negative, zero or positive as a is below, equal to or above b.
+ */
+static int	compare_long(const void *a, const void *b)
+{
+	return ((*(const long *)a > *(const long *)b)
+		- (*(const long *)a < *(const long *)b));
+}
+
+/**
+ * @brief Time an operation and print its percentiles on stderr.
+ *
+ * Runs a tenth of m->count warmup samples first, then m->count
+ * measured ones. Each sample is the mean time of batch calls, so that
+ * operations shorter than the clock itself still get a usable figure.
+ *
+ * @param m Pointer to the benchmark table, count already set.
+ * @param name Label printed in the first column.
+ * @param op Operation to time.
+ * @param batch Number of calls per sample.
+ */
+void	micro_run(t_micro *m, const char *name, void (*op)(t_micro *),
+			int batch)
+{
+	long	start;
+	int		i;
+	int		j;
+
+	i = -(m->count / 10);
+	while (i < m->count)
+	{
+		start = micro_now();
+		j = 0;
+		while (j++ < batch)
+			op(m);
+		if (i >= 0)
+			m->samples[i] = (micro_now() - start) / batch;
+		i++;
+	}
+	qsort(m->samples, m->count, sizeof(long), compare_long);
+	fprintf(stderr, "%-30s %6d %11ld %11ld %11ld %11ld\n", name, batch,
+		m->samples[m->count / 2], m->samples[m->count * 9 / 10],
+		m->samples[m->count * 99 / 100], m->samples[m->count - 1]);
+}
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   micro.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:58 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:58 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MICRO_H
+# define MICRO_H
+
+# include "philosophers.h"
+# include <time.h>
+
+# define MICRO_SAMPLES 1000
+# define MICRO_TTD "2147483647"
+# define MICRO_CPU_MAIN 0
+# define MICRO_CPU_PEER 1
+
+/*
+** One microbenchmark table. data is a real simulation state built by
+** the engine's own init functions, never started; philo is the seat
+** the measured operation acts on. Every sample times batch calls and
+** is stored in nanoseconds per call; the first tenth of the samples
+** are a warmup and are thrown away.
+*/
+typedef struct s_micro
+{
+	t_data			data;
+	t_philo			*philo;
+	long			arg;
+	int				count;
+	long			samples[MICRO_SAMPLES];
+	int				saved_fd;
+	int				pipe_fd[2];
+	pthread_t		peer;
+	atomic_bool		running;
+}	t_micro;
+
+// Runner
+long	micro_now(void);
+void	micro_pin(int cpu);
+void	micro_run(t_micro *m, const char *name, void (*op)(t_micro *),
+			int batch);
+
+// Setup
+int		micro_table(t_micro *m, char *num_philos);
+void	micro_stdout(t_micro *m, const char *path);
+void	micro_restore(t_micro *m);
+void	micro_pipe(t_micro *m);
+void	micro_contend(t_micro *m, bool start);
+
+// Cases
+void	op_time(t_micro *m);
+void	op_print(t_micro *m);
+void	op_sleep(t_micro *m);
+void	op_forks(t_micro *m);
+void	op_check(t_micro *m);
+
+#endif
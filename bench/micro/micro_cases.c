@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   micro_cases.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:59 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:59 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "micro.h"
+
+/**
+ * @brief Read the simulation clock once.
+ *
+ * The result is folded into m->arg so the call cannot be dropped.
+ *
+ * @param m Pointer to the benchmark table.
+ */
+void	op_time(t_micro *m)
+{
+	m->arg ^= get_time_us();
+}
+
+/**
+ * @brief Print one status line through the engine's logger.
+ *
+ * @param m Pointer to the benchmark table.
+ */
+void	op_print(t_micro *m)
+{
+	print_status(m->philo, "is thinking");
+}
+
+/**
+ * @brief Sleep for m->arg microseconds through precise_sleep.
+ *
+ * @param m Pointer to the benchmark table.
+ */
+void	op_sleep(t_micro *m)
+{
+	precise_sleep(m->arg, &m->data);
+}
+
+/**
+ * @brief Take and release the forks of philosopher 1.
+ *
+ * This is the engine's own path, so it includes the two "has taken a
+ * fork" lines and the short pause that take_forks makes after taking
+ * them.
+ *
+ * @param m Pointer to the benchmark table.
+ */
+void	op_forks(t_micro *m)
+{
+	if (take_forks(m->philo))
+		release_forks(m->philo);
+}
+
+/**
+ * @brief Run one monitor pass over every seat.
+ *
+ * @param m Pointer to the benchmark table.
+ */
+void	op_check(t_micro *m)
+{
+	check_death(&m->data);
+}
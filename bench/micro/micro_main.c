@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   micro_main.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:59 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:59 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "micro.h"
+
+/**
+ * @brief Keep taking the forks of philosopher 2 until told to stop.
+ *
+ * Philosopher 2 shares both forks with philosopher 1 on a ring of two.
+ *
+ * @param arg Pointer to the benchmark table cast as void*.
+ * @return Always returns NULL.
+ */
+static void	*peer_routine(void *arg)
+{
+	t_micro	*m;
+
+	m = (t_micro *)arg;
+	micro_pin(MICRO_CPU_PEER);
+	while (atomic_load(&m->running))
+	{
+		if (take_forks(&m->data.philos[1]))
+			release_forks(&m->data.philos[1]);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Start or stop the thread that competes for the forks.
+ *
+ * @param m Pointer to the benchmark table.
+ * @param start true to start the competing thread, false to stop it.
+ */
+void	micro_contend(t_micro *m, bool start)
+{
+	if (start)
+	{
+		atomic_store(&m->running, true);
+		if (pthread_create(&m->peer, NULL, peer_routine, m))
+			atomic_store(&m->running, false);
+		return ;
+	}
+	if (!atomic_load(&m->running))
+		return ;
+	atomic_store(&m->running, false);
+	pthread_join(m->peer, NULL);
+}
+
+/**
+ * @brief Time the clock, the logger and precise_sleep.
+ *
+ * @param m Pointer to a benchmark table of two philosophers.
+ */
+static void	micro_basic(t_micro *m)
+{
+	m->count = MICRO_SAMPLES;
+	micro_run(m, "get_time_us", op_time, 1000);
+	micro_stdout(m, "/dev/null");
+	micro_run(m, "print_status > /dev/null", op_print, 100);
+	micro_restore(m);
+	micro_pipe(m);
+	micro_run(m, "print_status | pipe", op_print, 100);
+	micro_restore(m);
+	m->count = 200;
+	m->arg = 1000;
+	micro_run(m, "precise_sleep 1ms", op_sleep, 1);
+	m->count = 50;
+	m->arg = 10000;
+	micro_run(m, "precise_sleep 10ms", op_sleep, 1);
+	m->count = 10;
+	m->arg = 200000;
+	micro_run(m, "precise_sleep 200ms", op_sleep, 1);
+}
+
+/**
+ * @brief Time a take_forks/release_forks pair, alone and contended.
+ *
+ * The fork lines go to /dev/null.
+ *
+ * @param m Pointer to a benchmark table of two philosophers.
+ */
+static void	micro_forks(t_micro *m)
+{
+	m->count = MICRO_SAMPLES;
+	micro_stdout(m, "/dev/null");
+	micro_run(m, "take+release_forks", op_forks, 1);
+	micro_contend(m, true);
+	micro_run(m, "take+release_forks contended", op_forks, 1);
+	micro_contend(m, false);
+	micro_restore(m);
+}
+
+/**
+ * @brief Run every hot-path microbenchmark and print the results.
+ *
+ * Results go to stderr, in nanoseconds per call, since stdout is
+ * redirected while the logger is measured. The main thread runs on
+ * CPU 0 and the helper threads (pipe reader, competing philosopher) on
+ * CPU 1.
+ *
+ * @return 0 on success.
+ */
+int	main(void)
+{
+	static t_micro	m;
+	static char		*sizes[] = {"10", "1000", "100000"};
+	static char		*names[] = {"check_death N=10",
+		"check_death N=1000", "check_death N=100000"};
+	int				i;
+
+	micro_pin(MICRO_CPU_MAIN);
+	fprintf(stderr, "%-30s %6s %11s %11s %11s %11s\n", "case", "batch",
+		"p50_ns", "p90_ns", "p99_ns", "max_ns");
+	if (micro_table(&m, "2") == 0)
+	{
+		micro_basic(&m);
+		micro_forks(&m);
+	}
+	cleanup(&m.data);
+	m.count = MICRO_SAMPLES / 10;
+	i = 0;
+	while (i < 3)
+	{
+		if (micro_table(&m, sizes[i]) == 0)
+			micro_run(&m, names[i], op_check, 1);
+		cleanup(&m.data);
+		i++;
+	}
+	return (0);
+}
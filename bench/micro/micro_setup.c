@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   micro_setup.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:58 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:58 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "micro.h"
+#include <fcntl.h>
+
+/**
+ * @brief Build a simulation state to measure, without starting it.
+ *
+ * Goes through the engine's own init functions on a plain ring of
+ * num_philos seats. time_to_die is set out of reach, so a check_death
+ * pass never finds a death however long the benchmark runs.
+ *
+ * @param m Pointer to the benchmark table.
+ * @param num_philos Number of philosophers, as a decimal string.
+ * @return 0 on success, 1 on failure; cleanup must run either way.
+ */
+int	micro_table(t_micro *m, char *num_philos)
+{
+	char	*av[6];
+	int		i;
+
+	av[0] = "philo_micro";
+	av[1] = num_philos;
+	av[2] = MICRO_TTD;
+	av[3] = "200";
+	av[4] = "200";
+	av[5] = NULL;
+	memset(&m->data.opts, 0, sizeof(t_opts));
+	init_data(&m->data, 5, av);
+	m->pipe_fd[0] = -1;
+	if (init_mutexes(&m->data) || elastic_configure(&m->data)
+		|| init_forks(&m->data) || init_philos(&m->data))
+		return (1);
+	m->data.start_time = get_time_us();
+	eating_start(&m->data);
+	i = 0;
+	while (i < m->data.num_philos)
+	{
+		m->data.philos[i].last_meal_time = m->data.start_time;
+		i++;
+	}
+	m->philo = &m->data.philos[0];
+	return (0);
+}
+
+/**
+ * @brief Send stdout to a file, keeping the original descriptor.
+ *
+ * @param m Pointer to the benchmark table.
+ * @param path File to write the log to.
+ */
+void	micro_stdout(t_micro *m, const char *path)
+{
+	int	fd;
+
+	fflush(stdout);
+	m->saved_fd = dup(STDOUT_FILENO);
+	fd = open(path, O_WRONLY);
+	dup2(fd, STDOUT_FILENO);
+	close(fd);
+}
+
+/**
+ * @brief Read a pipe until its writer closes it.
+ *
+ * @param arg Pointer to the benchmark table cast as void*.
+ * @return Always returns NULL.
+ */
+static void	*drain_routine(void *arg)
+{
+	t_micro	*m;
+	char	buf[4096];
+	ssize_t	bytes;
+
+	m = (t_micro *)arg;
+	micro_pin(MICRO_CPU_PEER);
+	bytes = 1;
+	while (bytes > 0)
+		bytes = read(m->pipe_fd[0], buf, sizeof(buf));
+	return (NULL);
+}
+
+/**
+ * @brief Send stdout into a pipe drained by a thread on another CPU.
+ *
+ * @param m Pointer to the benchmark table.
+ */
+void	micro_pipe(t_micro *m)
+{
+	if (pipe(m->pipe_fd))
+	{
+		m->pipe_fd[0] = -1;
+		return ;
+	}
+	pthread_create(&m->peer, NULL, drain_routine, m);
+	fflush(stdout);
+	m->saved_fd = dup(STDOUT_FILENO);
+	dup2(m->pipe_fd[1], STDOUT_FILENO);
+	close(m->pipe_fd[1]);
+}
+
+/**
+ * @brief Give stdout back and stop the pipe reader, if any.
+ *
+ * Restoring stdout closes the last write end of the pipe, so the
+ * reader sees end-of-file and exits.
+ *
+ * @param m Pointer to the benchmark table.
+ */
+void	micro_restore(t_micro *m)
+{
+	fflush(stdout);
+	dup2(m->saved_fd, STDOUT_FILENO);
+	close(m->saved_fd);
+	if (m->pipe_fd[0] < 0)
+		return ;
+	pthread_join(m->peer, NULL);
+	close(m->pipe_fd[0]);
+	m->pipe_fd[0] = -1;
+}
@@ -0,0 +1,37 @@
+#!/bin/sh
+# Cost of splitting the ring across processes: runs the same table in
+# one process and with --nodes=K, and reports the meal throughput, how
+# long a death took to reach the coordinator and the teardown latency
+# from --stats. Every run ends in a death (time_to_die < time_to_eat
+# + time_to_sleep) after a few meals.
+#
+# usage: bench/nodes.sh [runs] [philos] [nodes...]
+
+PHILO=${PHILO:-./philo}
+RUNS=${1:-5}
+[ $# -gt 0 ] && shift
+N=${1:-8}
+[ $# -gt 0 ] && shift
+NODES=${*:-"1 2 4"}
+
+printf '%6s %14s %12s %12s\n' "nodes" "meals_per_sec" "detect_us" \
+	"teardown_us"
+for k in $NODES; do
+	opt=
+	[ "$k" -gt 1 ] && opt=--nodes=$k
+	i=0
+	while [ $i -lt "$RUNS" ]; do
+		# shellcheck disable=SC2086
+		timeout 10 "$PHILO" "$N" 500 200 400 $opt --stats 2>&1 >/dev/null
+		i=$((i + 1))
+	done | awk -v k="$k" '
+		/^meals_per_sec/ { mps += $2; runs++ }
+		/^detect_us/ { det += $2 }
+		/^teardown_us/ { td += $2 }
+		END {
+			if (k > 1) printf "%6d %14d %12d %12d\n", k, mps / runs,
+				det / runs, td / runs
+			else printf "%6d %14d %12s %12d\n", k, mps / runs, "-",
+				td / runs
+		}'
+done
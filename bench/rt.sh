@@ -0,0 +1,47 @@
+#!/bin/sh
+# Default scheduler against --rt under CPU contention. Starts LOAD busy
+# loops per CPU, then runs a feasible ring (deaths and the smallest
+# margin before time_to_die, from --stats) and a fatal one, where the
+# first philosopher is due to die at time_to_die: how late the death
+# is reported past that point, on average and at worst.
+#
+# usage: bench/rt.sh [runs] [load]
+
+PHILO=${PHILO:-./philo}
+RUNS=${1:-5}
+LOAD=${2:-16}
+CPUS=$(getconf _NPROCESSORS_ONLN)
+PIDS=""
+
+trap 'kill $PIDS 2>/dev/null' EXIT INT TERM
+i=0
+while [ $i -lt $((LOAD * CPUS)) ]; do
+	sh -c 'while :; do :; done' &
+	PIDS="$PIDS $!"
+	i=$((i + 1))
+done
+
+printf '%8s %7s %14s %13s %13s\n' "sched" "deaths" "min_slack_ms" \
+	"late_avg_ms" "late_max_ms"
+for sched in default rt; do
+	opt=""
+	[ "$sched" = rt ] && opt="--rt"
+	i=0
+	while [ $i -lt "$RUNS" ]; do
+		timeout 30 "$PHILO" 4 410 200 200 10 $opt --stats 2>&1 \
+			| sed 's/^/ok /'
+		timeout 30 "$PHILO" 4 310 200 100 $opt | sed 's/^/ko /'
+		i=$((i + 1))
+	done | awk -v s="$sched" -v runs="$RUNS" '
+		BEGIN { min = 1e9 }
+		$1 == "ok" && $2 == "min_slack_ms" && $3 < min { min = $3 }
+		$1 == "ok" && / died$/ { deaths++ }
+		$1 == "ko" && / died$/ {
+			late += $2 - 310
+			if ($2 - 310 > max) max = $2 - 310
+		}
+		END {
+			printf "%8s %7d %14d %13.1f %13d\n", s, deaths, min,
+				late / runs, max
+		}'
+done
@@ -0,0 +1,40 @@
+#!/bin/sh
+# Teardown latency: time from the monitor stopping the simulation until
+# every philosopher thread is joined, as reported by --stats, and the
+# wall-clock time of the whole run. time_to_die < time_to_eat, so at the
+# moment of death half the table is eating and the other half is blocked
+# on a fork.
+#
+# Point PHILO at a build without --stats (e.g. an older checkout) to get
+# a baseline: only the wall-clock column is filled in then.
+#
+# usage: [PHILO=path] bench/teardown.sh [runs] [sizes...]
+
+PHILO=${PHILO:-./philo}
+RUNS=${1:-5}
+[ $# -gt 0 ] && shift
+SIZES=${*:-"2 10 100 1000"}
+STATS=--stats
+"$PHILO" 1 10 10 10 --stats >/dev/null 2>&1 || STATS=
+
+now_ms() {
+	date +%s%N | cut -c1-13
+}
+
+printf '%8s %12s %12s %12s %12s\n' "N" "min_us" "avg_us" "max_us" "wall_ms"
+for n in $SIZES; do
+	i=0
+	while [ $i -lt "$RUNS" ]; do
+		start=$(now_ms)
+		us=$("$PHILO" "$n" 150 200 100 $STATS 2>&1 >/dev/null \
+			| awk '/^teardown_us/ { print $2 }')
+		echo "${us:--1} $(($(now_ms) - start))"
+		i=$((i + 1))
+	done | awk -v n="$n" '
+		NR == 1 { min = $1; max = $1 }
+		{ sum += $1; wall += $2; if ($1 < min) min = $1; if ($1 > max) max = $1 }
+		END {
+			if (min < 0) printf "%8d %12s %12s %12s %12d\n", n, "-", "-", "-", wall / NR
+			else printf "%8d %12d %12d %12d %12d\n", n, min, sum / NR, max, wall / NR
+		}'
+done
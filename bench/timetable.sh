@@ -0,0 +1,48 @@
+#!/bin/sh
+# Dynamic fork locking against the static timetable (--timetable):
+# meal throughput, eating utilization and the smallest margin before
+# time_to_die (from --stats), plus the jitter of the interval between
+# two meals of a philosopher (standard deviation and worst case, from
+# the log), averaged over the runs, and the number of deaths.
+#
+# usage: bench/timetable.sh [runs] [sizes...]
+
+PHILO=${PHILO:-./philo}
+RUNS=${1:-5}
+[ $# -gt 0 ] && shift
+SIZES=${*:-"4 5 64 200"}
+
+printf '%6s %10s %14s %9s %13s %10s %11s %7s\n' "N" "engine" \
+	"meals_per_sec" "util_pct" "min_slack_ms" "gap_sd_ms" "gap_max_ms" \
+	"deaths"
+for n in $SIZES; do
+	for engine in dynamic timetable; do
+		opt=""
+		[ "$engine" = timetable ] && opt="--timetable"
+		i=0
+		while [ $i -lt "$RUNS" ]; do
+			timeout 30 "$PHILO" "$n" 800 200 200 10 $opt --stats 2>&1 \
+				| sed "s/^/$i /"
+			i=$((i + 1))
+		done | awk -v n="$n" -v e="$engine" -v runs="$RUNS" '
+			$2 == "meals_per_sec" { mps += $3 }
+			$2 == "eating_utilization_pct" { util += $3 }
+			$2 == "min_slack_ms" { slack += $3 }
+			$5 == "eating" {
+				k = $1 " " $3
+				if (k in last) {
+					d = $2 - last[k]
+					sum += d; sq += d * d; cnt++
+					if (d > max) max = d
+				}
+				last[k] = $2
+			}
+			/ died$/ { deaths++ }
+			END {
+				mean = cnt ? sum / cnt : 0
+				sd = cnt ? sqrt(sq / cnt - mean * mean) : 0
+				printf "%6d %10s %14d %9.1f %13.1f %10.1f %11d %7d\n", n,
+					e, mps / runs, util / runs, slack / runs, sd, max, deaths
+			}'
+	done
+done
@@ -6,7 +6,7 @@
 /*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/09 15:42:14 by maria-ol          #+#    #+#             */
-/*   Updated: 2026/01/12 19:50:43 by mona             ###   ########.fr       */
+/*   Updated: 2026/10/18 23:38:40 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,10 +19,58 @@
 # include <pthread.h>
 # include <sys/time.h>
 # include <stdbool.h>
+# include <string.h>
+# include <stdatomic.h>
+# include <poll.h>
+# include <sched.h>
+# include <sys/mman.h>
+# include <sys/resource.h>
 
 # define MONITOR_CHECK_INTERVAL 500
 # define SLEEP_CHECK_INTERVAL 500
 # define INT_MAX_VALUE 2147483647
+# define SCHEDULE_CAPACITY 1048576
+# define PHASE_EAT 0
+# define PHASE_SLEEP 1
+# define CONTROL_BUF_SIZE 256
+# define MSG_STATUS 0
+# define MSG_DIED 1
+# define MSG_DONE 2
+# define MSG_STOP 3
+# define MSG_STATS 4
+# define MSG_REQ 5
+# define MSG_GRANT 6
+# define MSG_REL 7
+# define WAIT_BUCKETS 32
+# define WORD_BITS 64
+# define PLAN_TRIALS 10
+# define PLAN_MEALS 5
+# define PLAN_MAX_MS 1000000
+# define PLAN_DIED 2
+# define FORK_REMOTE -2
+# define DETECT_INTERVAL 100
+# define DETECT_MISSES 64
+# define RT_MONITOR_PRIO 20
+# define RT_PHILO_PRIO 10
+# define PERF_COUNTERS 6
+# define PERF_PHILOS 0
+# define PERF_MONITOR 1
+# define PERF_NONE 0
+# define PERF_EVENT 1
+# define PERF_USER 2
+# define PERF_RUSAGE 3
+# define EAT_COUNT_BITS 20
+# define EAT_COUNT_MASK 0xfffff
+# if !defined(RUSAGE_THREAD) && defined(__linux__)
+#  define RUSAGE_THREAD 1
+# elif !defined(RUSAGE_THREAD)
+#  define RUSAGE_THREAD RUSAGE_SELF
+# endif
+# ifdef MCL_ONFAULT
+#  define RT_LOCK_FLAGS (MCL_CURRENT | MCL_ONFAULT)
+# else
+#  define RT_LOCK_FLAGS MCL_CURRENT
+# endif
 
 typedef enum e_error
 {
@@ -35,37 +83,286 @@ typedef enum e_error
 	ERR_INIT_FMUTEX,
 	ERR_ALOC,
 	ERR_PHILO_THREAD,
-	ERR_MONIT_THREAD
+	ERR_MONIT_THREAD,
+	ERR_OPTION,
+	ERR_SCHEDULE,
+	ERR_TOPOLOGY,
+	ERR_ELASTIC,
+	ERR_NODES,
+	ERR_BITMAP,
+	ERR_PLAN,
+	ERR_RT,
+	ERR_PERF,
+	ERR_TIMETABLE,
+	ERR_TIMETABLE_SLACK,
+	ERR_COUNT
 }				t_error;
 
 typedef struct s_data	t_data;
 
+typedef struct s_opts
+{
+	char			*record_path;
+	char			*replay_path;
+	char			*topology_path;
+	char			*control_path;
+	long			capacity;
+	long			nodes;
+	bool			bitmap;
+	long			plan;
+	long			jobs;
+	bool			detect;
+	int				rt_policy;
+	long			rt_monitor;
+	long			rt_philo;
+	bool			mlock;
+	bool			perf;
+	bool			stats;
+	bool			timetable;
+}	t_opts;
+
+/*
+** A fork is a mutex plus a futex word: gen is bumped on every release
+** (and on stop) so that waiters can sleep without polling. owner is
+** the index of the philosopher holding it (FORK_REMOTE for a fork
+** lent to another node, -1 when free), published for the deadlock
+** detector.
+*/
+typedef struct s_fork
+{
+	pthread_mutex_t	mutex;
+	atomic_int		gen;
+	atomic_int		waiters;
+	atomic_int		owner;
+}	t_fork;
+
+/*
+** One fork grant: which philosopher got both forks, when (us since
+** start), and how long the eat and sleep phases that followed took.
+** On replay, first is the index of the first grant sharing this
+** timestamp and next the index of the same philosopher's next grant.
+*/
+typedef struct s_cycle
+{
+	int				id;
+	long			grant;
+	long			eat;
+	long			sleep;
+	long			first;
+	long			next;
+}	t_cycle;
+
+typedef struct s_schedule
+{
+	t_cycle			*cycles;
+	long			capacity;
+	atomic_long		count;
+	long			pos;
+	bool			recording;
+	bool			replaying;
+	bool			initialized;
+	pthread_mutex_t	turn_mutex;
+	pthread_cond_t	turn_cond;
+}	t_schedule;
+
 typedef struct s_philo
 {
 	int				id;
 	int				meals_eaten;
 	long			last_meal_time;
+	long			cycle;
+	long			next_cycle;
 	pthread_t		thread;
-	pthread_mutex_t	*left_fork;
-	pthread_mutex_t	*right_fork;
+	t_fork			*left_fork;
+	t_fork			*right_fork;
+	int				*fork_ids;
+	int				num_forks;
+	int				seat_forks[2];
+	int				prev;
+	int				next;
+	atomic_bool		active;
+	atomic_bool		leaving;
+	bool			joinable;
+	bool			remote;
+	atomic_int		bell;
+	atomic_bool		waiting;
+	atomic_int		wait_fork;
+	atomic_int		misses;
+	pthread_mutex_t	seat_mutex;
 	t_data			*data;
 }	t_philo;
 
+/*
+** Elastic ring control channel: a FIFO read line by line, plus a
+** self-pipe written by simulation_stop to wake the control thread.
+*/
+typedef struct s_control
+{
+	int				fd;
+	int				wake[2];
+	int				len;
+	char			buf[CONTROL_BUF_SIZE];
+	bool			running;
+	pthread_t		thread;
+}	t_control;
+
+/*
+** Message exchanged between node processes and the coordinator. time
+** is in ms since the start of the simulation, stamp in absolute us.
+*/
+typedef struct s_msg
+{
+	int				type;
+	int				id;
+	int				code;
+	long			time;
+	long			stamp;
+}	t_msg;
+
+/*
+** One end of the socket between two neighbor nodes, which carries the
+** boundary fork homed on the server side. gen is the futex word the
+** boundary philosopher sleeps on while waiting for the grant.
+*/
+typedef struct s_link
+{
+	int				fd;
+	atomic_int		gen;
+	atomic_int		granted;
+	bool			running;
+	pthread_t		thread;
+}	t_link;
+
+/*
+** Distributed ring (--nodes): the coordinator polls one socket and
+** keeps one pid per node; a node process owns philosophers first..last, borrows its
+** last philosopher's right fork through client and lends fork first
+** through server.
+*/
+typedef struct s_node
+{
+	int				count;
+	int				index;
+	int				first;
+	int				last;
+	int				coord;
+	struct pollfd	*polls;
+	pid_t			*pids;
+	t_link			client;
+	t_link			server;
+	bool			reading;
+	int				done;
+	bool			done_sent;
+	pthread_t		reader;
+	long			meals;
+	long			detect_us;
+	long			stop_us;
+}	t_node;
+
+/*
+** Capacity planner (--plan): trials per candidate time_to_die, how
+** many run at once, the pids of the running ones (0 when free) and
+** the resolution of the search in microseconds.
+*/
+typedef struct s_plan
+{
+	long			trials;
+	long			step;
+	int				jobs;
+	int				running;
+	pid_t			*pids;
+}	t_plan;
+
+/*
+** Deadlock and livelock detector (--detect): scratch arrays of the
+** checker thread, and the signature of the last wait-for cycle seen.
+*/
+typedef struct s_detect
+{
+	pthread_t		thread;
+	bool			running;
+	int				*mark;
+	bool			*flagged;
+	long			suspect;
+	long			reported;
+}	t_detect;
+
+/*
+** --perf counters of one thread, opened by the thread itself: one
+** perf_event fd per counter (-1 if not counted that way) and the
+** getrusage snapshot taken when the thread started.
+*/
+typedef struct s_perf
+{
+	int				fd[PERF_COUNTERS];
+	struct rusage	usage;
+}	t_perf;
+
+/*
+** Eating-concurrency tracker (--stats). state packs the number of
+** philosophers eating (low EAT_COUNT_BITS bits) with the time of its
+** last change; the other fields are accumulated in microseconds since
+** start. max is floor(N/2), or 0 when the run is not tracked.
+*/
+typedef struct s_eating
+{
+	atomic_ullong	state;
+	atomic_llong	area;
+	atomic_llong	at_max;
+	atomic_llong	idle_max;
+	atomic_llong	below_since;
+	atomic_llong	below_max;
+	int				max;
+}	t_eating;
+
+/*
+** Shared simulation state. Every time and duration, start_time and the
+** philosophers' last_meal_time included, is kept in microseconds; the
+** log and --stats convert back to milliseconds.
+*/
 typedef struct s_data
 {
 	int				num_philos;
-	int				time_to_die;
-	int				time_to_eat;
-	int				time_to_sleep;
+	int				num_seats;
+	long			time_to_die;
+	long			time_to_eat;
+	long			time_to_sleep;
 	int				num_must_eat;
+	long			monitor_interval;
 	long			start_time;
+	long			meals_total;
+	long			min_slack;
 	bool			someone_died;
 	bool			all_ate_enough;
+	atomic_int		stop;
+	long			stop_time;
+	long			joined_time;
+	atomic_long		wait_hist[WAIT_BUCKETS];
+	atomic_long		wait_max;
+	t_eating		eating;
 	pthread_mutex_t	print_mutex;
 	pthread_mutex_t	death_mutex;
 	pthread_mutex_t	meal_mutex;
-	pthread_mutex_t	*forks;
+	t_fork			*forks;
+	int				num_forks;
+	atomic_ullong	*fork_bits;
+	int				*topo_offsets;
+	int				*topo_forks;
+	int				*fork_offsets;
+	int				*fork_philos;
 	t_philo			*philos;
+	t_opts			opts;
+	t_schedule		sched;
+	bool			elastic;
+	atomic_int		active_count;
+	t_control		control;
+	t_node			node;
+	t_detect		detect;
+	atomic_bool		rt_denied;
+	int				perf_mode[PERF_COUNTERS];
+	long			perf_tracepoint;
+	atomic_llong	perf_total[2][PERF_COUNTERS];
+	long			timetable_step;
 }	t_data;
 
 // Error handling
@@ -74,21 +371,135 @@ int		handle_error(t_error error);
 // Initialization
 int		init_data(t_data *data, int ac, char **av);
 int		init_mutexes(t_data *data);
+int		init_forks(t_data *data);
 int		init_philos(t_data *data);
 
+// Options
+int		parse_options(t_opts *opts, int argc, char **argv);
+char	*option_value(char *arg, const char *name);
+int		store_named(t_opts *opts, char *arg);
+
+// Schedule record and replay
+int		schedule_init(t_data *data);
+void	schedule_destroy(t_data *data);
+int		schedule_save(t_data *data);
+int		schedule_load(t_data *data);
+void	schedule_wait_turn(t_philo *philo);
+void	schedule_grant(t_philo *philo);
+long	schedule_duration(t_philo *philo, int phase, long planned);
+void	schedule_phase(t_philo *philo, int phase, long elapsed);
+
+// Conflict-graph topology
+int		topology_load(t_data *data);
+void	topology_assign(t_philo *philo);
+bool	take_graph_forks(t_philo *philo);
+void	release_graph_forks(t_philo *philo);
+
+// Simulation
+int		run_simulation(t_data *data);
+int		start_simulation(t_data *data);
+
+// Real-time scheduling
+int		rt_configure(t_data *data);
+void	rt_promote(t_data *data, pthread_t thread, long priority);
+void	rt_lock(t_data *data);
+
+// Synchronization cost counters
+int		perf_configure(t_data *data);
+int		perf_open(t_data *data, int counter, bool user_only);
+void	perf_begin(t_data *data, t_perf *perf);
+void	perf_end(t_data *data, t_perf *perf, int class);
+void	perf_report(t_data *data);
+
+// Static timetable
+int		timetable_configure(t_data *data);
+void	timetable_cycles(t_philo *philo);
+
+// Capacity planner
+int		plan_run(t_data *data);
+long	plan_candidate(t_data *data, t_plan *plan, long time_to_die);
+
+// Elastic ring
+int		elastic_configure(t_data *data);
+int		seat_init(t_philo *philo, int seat);
+void	seat_set_forks(t_philo *philo, int left, int right);
+int		seat_add(t_data *data, int after);
+int		seat_remove(t_data *data, int seat);
+void	seat_event(t_data *data, int seat, char *event);
+void	seat_gate(t_philo *seat);
+void	control_init(t_control *control);
+void	philo_yield(t_philo *philo);
+int		elastic_start(t_data *data);
+void	elastic_join(t_data *data);
+void	*control_routine(void *arg);
+
+// Distributed ring
+int		nodes_configure(t_data *data);
+void	node_init(t_node *node);
+int		nodes_coordinate(t_data *data);
+void	node_segment(t_data *data, int index);
+void	node_print(t_data *data, int id, char *status, long time);
+int		nodes_start(t_data *data);
+int		node_start(t_data *data);
+void	node_join(t_data *data);
+bool	node_done(t_data *data);
+int		node_send(int fd, t_msg *msg);
+char	*node_status_text(int code);
+bool	node_take_forks(t_philo *philo);
+void	node_release_forks(t_philo *philo);
+void	*link_client_routine(void *arg);
+void	*link_server_routine(void *arg);
+
+// Lock-free bitmap forks
+int		bitmap_configure(t_data *data);
+bool	bitmap_take(t_philo *philo);
+void	bitmap_release(t_philo *philo);
+void	bitmap_ring(t_philo *philo);
+void	bitmap_wake_all(t_data *data);
+
+// Deadlock and livelock detector
+int		detect_start(t_data *data);
+void	detect_join(t_data *data);
+void	*detect_routine(void *arg);
+void	detect_cycles(t_data *data);
+void	detect_livelock(t_data *data);
+
+// Forks and shutdown
+int		fork_init(t_fork *fork);
+bool	fork_lock(t_data *data, t_fork *fork, int who);
+void	fork_unlock(t_fork *fork);
+bool	fork_take_pair(t_philo *philo, t_fork *first, t_fork *second);
+void	futex_wait(atomic_int *addr, int expected, long timeout_us);
+void	futex_wake(atomic_int *addr, int count);
+void	timer_tighten(t_data *data);
+void	simulation_stop(t_data *data);
+bool	simulation_over(t_data *data);
+
+// Statistics
+void	stats_init(t_data *data);
+void	stats_forks_taken(t_philo *philo, long wait_start);
+void	stats_report(t_data *data);
+void	eating_start(t_data *data);
+void	eating_change(t_data *data, int delta);
+void	eating_report(t_data *data);
+
 // Utils
-long	get_time(void);
-void	precise_sleep(long milliseconds, t_data *data);
+long	get_time_us(void);
+void	precise_sleep(long microseconds, t_data *data);
+void	print_ms(FILE *out, char *before, long us, char *after);
 int		ft_atoi(const char *str);
 long	ft_atol(const char *str);
 int		is_valid_number(const char *str);
+long	duration_scale(const char *str);
 void	print_status(t_philo *philo, char *status);
 
 // Routine
 void	*philo_routine(void *arg);
 
 // Actions
-void	philo_eat(t_philo *philo);
+bool	take_forks(t_philo *philo);
+void	release_forks(t_philo *philo);
+bool	philo_eat(t_philo *philo);
 void	philo_sleep(t_philo *philo);
 void	philo_think(t_philo *philo);
 
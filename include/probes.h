@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   probes.h                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:41:12 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:41:12 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROBES_H
+# define PROBES_H
+
+/*
+** USDT probes (provider "philo") at every state transition, for perf
+** and bpftrace. They are compiled in when <sys/sdt.h> is available,
+** unless built with -DPHILO_NO_PROBES; otherwise every probe expands
+** to nothing.
+**
+** Each probe has a semaphore that tracers increment while attached,
+** so a probe site costs one load and branch when nobody listens, and
+** its arguments (timestamps included) are only computed when someone
+** does. Timestamps are microseconds from get_time_us().
+**
+** fork_taken    (id, fork, now_us)      id is -1 for a fork lent to
+**                                       another --nodes process
+** forks_granted (id, wait_start_us, now_us)
+** eat_start     (id, meal, now_us)
+** eat_end       (id, meal, now_us)
+** sleep         (id, now_us)
+** think         (id, now_us)
+** check         (id, slack_us, now_us)  one per seat and monitor pass
+** death         (id, now_us)
+** status        (id, timestamp_ms, text)
+*/
+# if defined(__has_include) && !defined(PHILO_NO_PROBES)
+#  if __has_include(<sys/sdt.h>)
+#   define PHILO_PROBES 1
+#  endif
+# endif
+
+# ifdef PHILO_PROBES
+#  define _SDT_HAS_SEMAPHORES 1
+#  include <sys/sdt.h>
+
+extern unsigned short	philo_fork_taken_semaphore;
+extern unsigned short	philo_forks_granted_semaphore;
+extern unsigned short	philo_eat_start_semaphore;
+extern unsigned short	philo_eat_end_semaphore;
+extern unsigned short	philo_sleep_semaphore;
+extern unsigned short	philo_think_semaphore;
+extern unsigned short	philo_check_semaphore;
+extern unsigned short	philo_death_semaphore;
+extern unsigned short	philo_status_semaphore;
+
+#  define PROBE2(n, a, b) do { if (philo_##n##_semaphore) \
+	STAP_PROBE2(philo, n, a, b); } while (0)
+#  define PROBE3(n, a, b, c) do { if (philo_##n##_semaphore) \
+	STAP_PROBE3(philo, n, a, b, c); } while (0)
+# else
+#  define PROBE2(n, a, b) do { } while (0)
+#  define PROBE3(n, a, b, c) do { } while (0)
+# endif
+
+#endif
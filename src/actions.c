@@ -6,57 +6,84 @@
 /*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/09 16:40:28 by maria-ol          #+#    #+#             */
-/*   Updated: 2026/01/11 18:28:38 by mona             ###   ########.fr       */
+/*   Updated: 2026/10/18 23:38:40 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philosophers.h"
+#include "probes.h"
 
 /**
  * @brief Take forks in the correct order to prevent deadlock.
  *
  * Philosophers with even IDs take right fork first, odd IDs take
  * left fork first. A small delay after taking forks helps prevent
- * starvation in edge cases.
+ * starvation in edge cases; it is capped at a hundredth of
+ * time_to_eat so that it stays small next to sub-millisecond meals.
+ * On a --topology graph the forks are taken in global index order
+ * instead; the last philosopher of a --nodes segment borrows its right
+ * fork from the next node. With --forks=bitmap both forks are claimed
+ * at once, with no ordering.
  *
  * @param philo Pointer to the philosopher structure.
+ * @return true if both forks were taken, false if the simulation stopped.
  */
-static void	take_forks(t_philo *philo)
+bool	take_forks(t_philo *philo)
 {
+	long	delay;
+
+	if (philo->data->fork_bits)
+		return (bitmap_take(philo));
+	if (philo->fork_ids)
+		return (take_graph_forks(philo));
+	if (philo->remote)
+		return (node_take_forks(philo));
 	if (philo->id % 2 == 0)
 	{
-		pthread_mutex_lock(philo->right_fork);
-		print_status(philo, "has taken a fork");
-		pthread_mutex_lock(philo->left_fork);
-		print_status(philo, "has taken a fork");
-		usleep(100);
+		if (!fork_take_pair(philo, philo->right_fork, philo->left_fork))
+			return (false);
+		delay = philo->data->time_to_eat / 100;
+		if (delay > 100)
+			delay = 100;
+		usleep(delay);
 	}
 	else
 	{
-		pthread_mutex_lock(philo->left_fork);
-		print_status(philo, "has taken a fork");
-		pthread_mutex_lock(philo->right_fork);
-		print_status(philo, "has taken a fork");
+		if (!fork_take_pair(philo, philo->left_fork, philo->right_fork))
+			return (false);
 		usleep(1);
 	}
+	return (true);
 }
 
 /**
  * @brief Release forks in reverse order.
  *
+ * The meal ends here for the --stats eating-concurrency tracker.
+ *
  * @param philo Pointer to the philosopher structure.
  */
-static void	release_forks(t_philo *philo)
+void	release_forks(t_philo *philo)
 {
-	if (philo->id % 2 == 0)
+	eating_change(philo->data, -1);
+	if (philo->data->fork_bits)
+		bitmap_release(philo);
+	else if (philo->fork_ids)
+		release_graph_forks(philo);
+	else if (philo->remote)
 	{
-		pthread_mutex_unlock(philo->left_fork);
-		pthread_mutex_unlock(philo->right_fork);
+		fork_unlock(philo->left_fork);
+		node_release_forks(philo);
+	}
+	else if (philo->id % 2 == 0)
+	{
+		fork_unlock(philo->left_fork);
+		fork_unlock(philo->right_fork);
 	}
 	else
 	{
-		pthread_mutex_unlock(philo->right_fork);
-		pthread_mutex_unlock(philo->left_fork);
+		fork_unlock(philo->right_fork);
+		fork_unlock(philo->left_fork);
 	}
 }
 
@@ -69,21 +96,43 @@ static void	release_forks(t_philo *philo)
  * deadlock. After acquiring both forks, the philosopher updates
  * their last meal time and increments their meal count. The
  * philosopher then sleeps for the duration of eating before
- * releasing the forks.
+ * releasing the forks. When a schedule is being replayed, the
+ * philosopher first waits for its recorded turn; on a --topology graph
+ * or an elastic ring it first lets hungrier fork sharers eat. With
+ * --stats, the time spent getting the forks is accounted for. The
+ * eat_start and eat_end probes bracket the meal (see probes.h).
  *
  * @param philo Pointer to the philosopher structure performing
  *              the eating action.
+ * @return true once the meal is over, false if the simulation stopped
+ *         before the forks could be taken.
  */
-void	philo_eat(t_philo *philo)
+bool	philo_eat(t_philo *philo)
 {
-	take_forks(philo);
+	long	start;
+
+	schedule_wait_turn(philo);
+	start = get_time_us();
+	if (philo->fork_ids)
+		philo_yield(philo);
+	if (!take_forks(philo))
+		return (false);
+	stats_forks_taken(philo, start);
+	schedule_grant(philo);
 	print_status(philo, "is eating");
+	start = get_time_us();
 	pthread_mutex_lock(&philo->data->meal_mutex);
-	philo->last_meal_time = get_time();
+	philo->last_meal_time = start;
 	philo->meals_eaten++;
+	philo->data->meals_total++;
 	pthread_mutex_unlock(&philo->data->meal_mutex);
-	precise_sleep(philo->data->time_to_eat, philo->data);
+	PROBE3(eat_start, philo->id, philo->meals_eaten, start);
+	precise_sleep(schedule_duration(philo, PHASE_EAT,
+			philo->data->time_to_eat), philo->data);
+	schedule_phase(philo, PHASE_EAT, get_time_us() - start);
+	PROBE3(eat_end, philo->id, philo->meals_eaten, get_time_us());
 	release_forks(philo);
+	return (true);
 }
 
 /**
@@ -99,8 +148,14 @@ void	philo_eat(t_philo *philo)
  */
 void	philo_sleep(t_philo *philo)
 {
+	long	start;
+
 	print_status(philo, "is sleeping");
-	precise_sleep(philo->data->time_to_sleep, philo->data);
+	start = get_time_us();
+	PROBE2(sleep, philo->id, start);
+	precise_sleep(schedule_duration(philo, PHASE_SLEEP,
+			philo->data->time_to_sleep), philo->data);
+	schedule_phase(philo, PHASE_SLEEP, get_time_us() - start);
 }
 
 /**
@@ -108,7 +163,10 @@ void	philo_sleep(t_philo *philo)
  *
  * This function implements the thinking action for a philosopher.
  * For odd numbers of philosophers, a small thinking delay is added
- * to prevent starvation.
+ * to prevent starvation. The delay is tuned for the classic ring: a
+ * --topology graph or an elastic ring (where philo_yield lets the
+ * hungrier sharer go first) does not use it. The delay is
+ * interrupted when the simulation stops.
  *
  * @param philo Pointer to the philosopher structure performing
  *              the thinking action.
@@ -118,14 +176,15 @@ void	philo_think(t_philo *philo)
 	long	think_time;
 
 	print_status(philo, "is thinking");
-	if (philo->data->num_philos % 2 != 0)
+	PROBE2(think, philo->id, get_time_us());
+	if (philo->data->num_philos % 2 != 0 && !philo->fork_ids)
 	{
 		think_time = philo->data->time_to_eat * 2 - philo->data->time_to_sleep;
 		if (think_time < 0)
 			think_time = 0;
-		if (think_time > 600)
-			think_time = 200;
+		if (think_time > 600000)
+			think_time = 200000;
 		if (think_time > 0)
-			usleep(think_time * 1000);
+			precise_sleep(think_time, philo->data);
 	}
 }
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bitmap.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:05:12 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:05:12 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Allocate the fork bitmap for --forks=bitmap.
+ *
+ * Bit i of the bitmap is set while fork i is in use. The bitmap engine
+ * relies on the classic ring layout (philosopher i uses forks i and
+ * i + 1), so it cannot be combined with --topology, --control or
+ * --nodes.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success (or without --forks=bitmap), 1 on failure.
+ */
+int	bitmap_configure(t_data *data)
+{
+	int	words;
+	int	i;
+
+	if (!data->opts.bitmap)
+		return (0);
+	if (data->topo_forks || data->elastic || data->node.count)
+		return (handle_error(ERR_BITMAP));
+	words = (data->num_forks + WORD_BITS - 1) / WORD_BITS;
+	data->fork_bits = malloc(sizeof(atomic_ullong) * words);
+	if (!data->fork_bits)
+		return (handle_error(ERR_ALOC));
+	i = 0;
+	while (i < words)
+	{
+		atomic_init(&data->fork_bits[i], 0);
+		i++;
+	}
+	return (0);
+}
+
+/**
+ * @brief Wake a philosopher if it sleeps waiting for its forks.
+ *
+ * Each philosopher sleeps on its own futex word, so a release only
+ * wakes the two neighbors that may want the freed forks, and only
+ * those that are actually waiting cost a system call.
+ *
+ * @param philo Pointer to the philosopher to wake.
+ */
+void	bitmap_ring(t_philo *philo)
+{
+	if (!atomic_load(&philo->waiting))
+		return ;
+	atomic_fetch_add(&philo->bell, 1);
+	futex_wake(&philo->bell, 1);
+}
+
+/**
+ * @brief Wake every philosopher waiting for its forks, on stop.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	bitmap_wake_all(t_data *data)
+{
+	int	i;
+
+	i = 0;
+	while (i < data->num_philos)
+	{
+		bitmap_ring(&data->philos[i]);
+		i++;
+	}
+}
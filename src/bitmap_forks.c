@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bitmap_forks.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:11:40 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:20:21 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include "probes.h"
+
+/**
+ * @brief Set every bit of a mask in one compare-and-swap.
+ *
+ * @param word The bitmap word holding the bits.
+ * @param mask The bits to claim.
+ * @return true if all bits were free and are now set, false otherwise.
+ */
+static bool	bits_claim(atomic_ullong *word, unsigned long long mask)
+{
+	unsigned long long	old;
+
+	old = atomic_load(word);
+	while ((old & mask) == 0)
+	{
+		if (atomic_compare_exchange_weak(word, &old, old | mask))
+			return (true);
+	}
+	return (false);
+}
+
+/**
+ * @brief Claim both of a philosopher's forks, or none of them.
+ *
+ * When both bits live in the same word, which includes the wraparound
+ * pair of the last philosopher on rings of up to WORD_BITS forks, a
+ * single compare-and-swap claims them together. Otherwise the left bit
+ * is claimed first and given back if the right one is taken, so a
+ * philosopher never holds one fork while waiting for the other.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @return true if both forks are now held, false otherwise.
+ */
+static bool	forks_claim(t_philo *philo)
+{
+	atomic_ullong	*bits;
+	int				left;
+	int				right;
+
+	bits = philo->data->fork_bits;
+	left = philo->id - 1;
+	right = philo->id % philo->data->num_philos;
+	if (left / WORD_BITS == right / WORD_BITS)
+		return (bits_claim(&bits[left / WORD_BITS],
+				(1ULL << (left % WORD_BITS)) | (1ULL << (right % WORD_BITS))));
+	if (!bits_claim(&bits[left / WORD_BITS], 1ULL << (left % WORD_BITS)))
+		return (false);
+	if (bits_claim(&bits[right / WORD_BITS], 1ULL << (right % WORD_BITS)))
+		return (true);
+	atomic_fetch_and(&bits[left / WORD_BITS], ~(1ULL << (left % WORD_BITS)));
+	bitmap_ring(&philo->data->philos[(left + philo->data->num_philos - 1)
+		% philo->data->num_philos]);
+	return (false);
+}
+
+/**
+ * @brief Take both forks through the bitmap, giving up on stop.
+ *
+ * A philosopher that finds a fork in use raises its waiting flag and
+ * sleeps on its own futex word until a neighbor releases a fork. The
+ * word is sampled before the flag is raised and the claim retried, so
+ * a release in between makes futex_wait return at once.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @return true if both forks were taken, false if the simulation stopped.
+ */
+bool	bitmap_take(t_philo *philo)
+{
+	int	bell;
+
+	while (!forks_claim(philo))
+	{
+		bell = atomic_load(&philo->bell);
+		atomic_store(&philo->waiting, true);
+		if (forks_claim(philo))
+			break ;
+		atomic_fetch_add_explicit(&philo->misses, 1, memory_order_relaxed);
+		if (simulation_over(philo->data))
+		{
+			atomic_store(&philo->waiting, false);
+			return (false);
+		}
+		futex_wait(&philo->bell, bell, -1);
+		atomic_store(&philo->waiting, false);
+	}
+	atomic_store(&philo->waiting, false);
+	PROBE3(fork_taken, philo->id, philo->id - 1, get_time_us());
+	PROBE3(fork_taken, philo->id, philo->id % philo->data->num_philos,
+		get_time_us());
+	print_status(philo, "has taken a fork");
+	print_status(philo, "has taken a fork");
+	return (true);
+}
+
+/**
+ * @brief Release both forks and wake the neighbors waiting for them.
+ *
+ * @param philo Pointer to the philosopher structure.
+ */
+void	bitmap_release(t_philo *philo)
+{
+	atomic_ullong	*bits;
+	int				left;
+	int				right;
+	int				n;
+
+	bits = philo->data->fork_bits;
+	n = philo->data->num_philos;
+	left = philo->id - 1;
+	right = philo->id % n;
+	if (left / WORD_BITS == right / WORD_BITS)
+		atomic_fetch_and(&bits[left / WORD_BITS],
+			~((1ULL << (left % WORD_BITS)) | (1ULL << (right % WORD_BITS))));
+	else
+	{
+		atomic_fetch_and(&bits[left / WORD_BITS],
+			~(1ULL << (left % WORD_BITS)));
+		atomic_fetch_and(&bits[right / WORD_BITS],
+			~(1ULL << (right % WORD_BITS)));
+	}
+	bitmap_ring(&philo->data->philos[(left + n - 1) % n]);
+	bitmap_ring(&philo->data->philos[right]);
+}
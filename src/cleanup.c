@@ -6,7 +6,7 @@
 /*   By: maria-ol <maria-ol@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/07 13:47:10 by mona              #+#    #+#             */
-/*   Updated: 2026/01/09 15:51:57 by maria-ol         ###   ########.fr       */
+/*   Updated: 2026/10/18 22:58:56 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -33,20 +33,41 @@ void	destroy_mutexes(t_data *data)
 	if (data->forks)
 	{
 		i = 0;
-		while (i < data->num_philos)
+		while (i < data->num_forks)
 		{
-			pthread_mutex_destroy(&data->forks[i]);
+			pthread_mutex_destroy(&data->forks[i].mutex);
 			i++;
 		}
 	}
 }
 
+/**
+ * @brief Destroy the seat mutexes of an elastic ring.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+static void	destroy_seats(t_data *data)
+{
+	int	i;
+
+	if (!data->elastic || !data->philos)
+		return ;
+	i = 0;
+	while (i < data->num_seats)
+	{
+		pthread_mutex_destroy(&data->philos[i].seat_mutex);
+		i++;
+	}
+}
+
 /**
  * @brief Clean up all resources allocated during the simulation.
  *
  * This function performs a complete cleanup of all resources that were
  * allocated during the simulation. It destroys all mutexes and frees
- * all dynamically allocated memory (forks and philosophers arrays).
+ * all dynamically allocated memory (forks, fork bitmap and
+ * philosophers arrays, the conflict graph, and the recorded or
+ * replayed schedule).
  * It should be called before the program exits to prevent memory
  * leaks and ensure proper resource deallocation.
  *
@@ -56,8 +77,17 @@ void	destroy_mutexes(t_data *data)
 void	cleanup(t_data *data)
 {
 	destroy_mutexes(data);
+	destroy_seats(data);
+	schedule_destroy(data);
 	if (data->forks)
 		free(data->forks);
 	if (data->philos)
 		free(data->philos);
+	free(data->topo_offsets);
+	free(data->topo_forks);
+	free(data->fork_offsets);
+	free(data->fork_philos);
+	free(data->fork_bits);
+	free(data->node.polls);
+	free(data->node.pids);
 }
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   detect.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:52:19 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Start the deadlock and livelock checker with --detect.
+ *
+ * Philosophers always publish the forks they hold and wait for (see
+ * fork_lock), at the cost of a relaxed store; the checker thread that
+ * reads them only runs on request.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success (or without --detect), 1 on failure.
+ */
+int	detect_start(t_data *data)
+{
+	if (!data->opts.detect)
+		return (0);
+	data->detect.mark = malloc(sizeof(int) * data->num_seats);
+	data->detect.flagged = calloc(data->num_seats, sizeof(bool));
+	if (!data->detect.mark || !data->detect.flagged)
+		return (handle_error(ERR_ALOC));
+	data->detect.suspect = 0;
+	data->detect.reported = 0;
+	if (pthread_create(&data->detect.thread, NULL, detect_routine, data))
+		return (handle_error(ERR_MONIT_THREAD));
+	data->detect.running = true;
+	return (0);
+}
+
+/**
+ * @brief Wait for the checker thread and free its scratch arrays.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	detect_join(t_data *data)
+{
+	if (data->detect.running)
+		pthread_join(data->detect.thread, NULL);
+	data->detect.running = false;
+	free(data->detect.mark);
+	free(data->detect.flagged);
+	data->detect.mark = NULL;
+	data->detect.flagged = NULL;
+}
+
+/**
+ * @brief Print a livelock suspect on stderr.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param seat Index of the philosopher.
+ * @param misses Number of missed attempts since its last meal.
+ */
+static void	report_livelock(t_data *data, int seat, int misses)
+{
+	long	last_meal;
+
+	pthread_mutex_lock(&data->meal_mutex);
+	last_meal = data->philos[seat].last_meal_time;
+	pthread_mutex_unlock(&data->meal_mutex);
+	pthread_mutex_lock(&data->print_mutex);
+	fprintf(stderr, "%ld detect: livelock: %d missed its forks %d times"
+		" since its last meal at %ld\n",
+		(get_time_us() - data->start_time) / 1000, seat + 1, misses,
+		(last_meal - data->start_time) / 1000);
+	pthread_mutex_unlock(&data->print_mutex);
+}
+
+/**
+ * @brief Flag philosophers whose fork attempts keep failing.
+ *
+ * A philosopher is flagged, once per meal, when it has missed its
+ * forks DETECT_MISSES times since its last meal: it keeps being woken
+ * and losing the race, which a slow but progressing run does not do.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	detect_livelock(t_data *data)
+{
+	int	seat;
+	int	misses;
+
+	seat = 0;
+	while (seat < data->num_seats)
+	{
+		misses = atomic_load_explicit(&data->philos[seat].misses,
+				memory_order_relaxed);
+		if (misses < DETECT_MISSES)
+			data->detect.flagged[seat] = false;
+		else if (!data->detect.flagged[seat]
+			&& atomic_load(&data->philos[seat].active))
+		{
+			data->detect.flagged[seat] = true;
+			report_livelock(data, seat, misses);
+		}
+		seat++;
+	}
+}
+
+/**
+ * @brief Checker thread: scan the wait-for graph every DETECT_INTERVAL.
+ *
+ * The thread sleeps on the stop word, so it exits as soon as the
+ * simulation stops. Its findings go to stderr.
+ *
+ * @param arg Pointer to the shared data structure cast as void*.
+ * @return Always returns NULL when the simulation ends.
+ */
+void	*detect_routine(void *arg)
+{
+	t_data	*data;
+
+	data = (t_data *)arg;
+	while (!simulation_over(data))
+	{
+		futex_wait(&data->stop, 0, DETECT_INTERVAL * 1000L);
+		if (simulation_over(data))
+			break ;
+		detect_cycles(data);
+		detect_livelock(data);
+	}
+	return (NULL);
+}
@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   detect_graph.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:58:03 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Follow one edge of the wait-for graph.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param seat Index of a philosopher.
+ * @return Index of the philosopher holding the fork seat waits for, or
+ *         -1 if it waits for nothing, or for a free or lent fork.
+ */
+static int	waits_for(t_data *data, int seat)
+{
+	int	fork;
+
+	if (!atomic_load(&data->philos[seat].active))
+		return (-1);
+	fork = atomic_load_explicit(&data->philos[seat].wait_fork,
+			memory_order_relaxed);
+	if (fork < 0)
+		return (-1);
+	return (atomic_load_explicit(&data->forks[fork].owner,
+			memory_order_relaxed));
+}
+
+/**
+ * @brief Walk a cycle and compute a signature of its edges.
+ *
+ * The table is read without locks, so the walk gives up after
+ * num_seats steps or on a broken edge, and returns 0 in that case.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param start Index of a philosopher on the cycle.
+ * @return A non-zero signature of the cycle, or 0 if it vanished.
+ */
+static long	cycle_signature(t_data *data, int start)
+{
+	long	signature;
+	int		seat;
+	int		steps;
+
+	signature = 0;
+	seat = start;
+	steps = 0;
+	while (steps < data->num_seats)
+	{
+		signature = signature * 31 + seat * 7919L + 1
+			+ atomic_load(&data->philos[seat].wait_fork);
+		seat = waits_for(data, seat);
+		if (seat < 0)
+			return (0);
+		if (seat == start)
+			return (signature | 1);
+		steps++;
+	}
+	return (0);
+}
+
+/**
+ * @brief Print the chain of a wait-for cycle on stderr.
+ *
+ * Each edge reads "philosopher -(fork)-> holder of that fork".
+ *
+ * @param data Pointer to the shared data structure.
+ * @param start Index of a philosopher on the cycle.
+ */
+static void	report_cycle(t_data *data, int start)
+{
+	int	seat;
+	int	steps;
+
+	pthread_mutex_lock(&data->print_mutex);
+	fprintf(stderr, "%ld detect: deadlock: %d",
+		(get_time_us() - data->start_time) / 1000, start + 1);
+	seat = start;
+	steps = 0;
+	while (steps < data->num_seats)
+	{
+		steps++;
+		fprintf(stderr, " -(fork %d)-> ",
+			atomic_load(&data->philos[seat].wait_fork) + 1);
+		seat = waits_for(data, seat);
+		if (seat < 0)
+			break ;
+		fprintf(stderr, "%d", seat + 1);
+		if (seat == start)
+			break ;
+	}
+	fprintf(stderr, "\n");
+	pthread_mutex_unlock(&data->print_mutex);
+}
+
+/**
+ * @brief Find a philosopher on a cycle of the wait-for graph.
+ *
+ * Each philosopher waits for at most one fork, held by at most one
+ * philosopher, so the graph has out-degree one: walking from every
+ * unmarked philosopher and marking the walk with its origin finds any
+ * cycle in a single O(N) pass.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return Index of a philosopher on a cycle, or -1 if there is none.
+ */
+static int	find_cycle(t_data *data)
+{
+	int	seat;
+	int	next;
+
+	seat = 0;
+	while (seat < data->num_seats)
+	{
+		data->detect.mark[seat] = -1;
+		seat++;
+	}
+	seat = 0;
+	while (seat < data->num_seats)
+	{
+		next = seat;
+		while (next >= 0 && data->detect.mark[next] < 0)
+		{
+			data->detect.mark[next] = seat;
+			next = waits_for(data, next);
+		}
+		if (next >= 0 && data->detect.mark[next] == seat)
+			return (next);
+		seat++;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Report a deadlock once its cycle has been seen twice.
+ *
+ * A cycle is only reported once it has been seen unchanged on two
+ * consecutive passes, which filters out the transient cycles a
+ * lock-free snapshot can show, and only once.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	detect_cycles(t_data *data)
+{
+	int		start;
+	long	signature;
+
+	start = find_cycle(data);
+	signature = 0;
+	if (start >= 0)
+		signature = cycle_signature(data, start);
+	if (signature && signature == data->detect.suspect
+		&& signature != data->detect.reported)
+	{
+		report_cycle(data, start);
+		data->detect.reported = signature;
+	}
+	data->detect.suspect = signature;
+}
@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   eating.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:48 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:48 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Reset the eating-concurrency tracker before the threads start.
+ *
+ * Only a --stats run on a single process is tracked: everywhere else
+ * max stays 0 and eating_change returns at once. The best any schedule
+ * can do on a ring is floor(N/2) philosophers eating together.
+ *
+ * @param data Pointer to the shared data structure, start_time set.
+ */
+void	eating_start(t_data *data)
+{
+	t_eating	*eat;
+
+	eat = &data->eating;
+	eat->max = 0;
+	if (data->opts.stats && !data->node.count)
+		eat->max = data->num_philos / 2;
+	atomic_init(&eat->state, 0);
+	atomic_init(&eat->area, 0);
+	atomic_init(&eat->at_max, 0);
+	atomic_init(&eat->idle_max, 0);
+	atomic_init(&eat->below_since, 0);
+	atomic_init(&eat->below_max, 0);
+}
+
+/**
+ * @brief Raise an atomic maximum without a lock.
+ *
+ * @param max Pointer to the running maximum.
+ * @param value Candidate value.
+ */
+static void	atomic_raise(atomic_llong *max, long long value)
+{
+	long long	seen;
+
+	seen = atomic_load_explicit(max, memory_order_relaxed);
+	while (value > seen)
+	{
+		if (atomic_compare_exchange_weak_explicit(max, &seen, value,
+				memory_order_relaxed, memory_order_relaxed))
+			return ;
+	}
+}
+
+/**
+ * @brief Account for one interval during which count philosophers ate.
+ *
+ * @param eat Pointer to the tracker.
+ * @param count Number of philosophers eating over the interval.
+ * @param from Start of the interval, in microseconds since start.
+ * @param to End of the interval, in microseconds since start.
+ */
+static void	eating_account(t_eating *eat, long count, long from, long to)
+{
+	atomic_fetch_add_explicit(&eat->area, count * (to - from),
+		memory_order_relaxed);
+	if (count >= eat->max)
+		atomic_fetch_add_explicit(&eat->at_max, to - from,
+			memory_order_relaxed);
+	if (count == 0)
+		atomic_raise(&eat->idle_max, to - from);
+}
+
+/**
+ * @brief Record a philosopher starting (+1) or finishing (-1) a meal.
+ *
+ * The state word packs the number of philosophers eating with the time
+ * of its last change, so each interval between two changes is closed
+ * exactly once, by the thread whose compare-and-swap ends it. A thread
+ * that brings the count below the maximum stamps below_since before
+ * its swap, so the thread that brings it back sees the stamp; two
+ * threads leaving the maximum together may skew it by their race.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param delta +1 when the forks are granted, -1 when released.
+ */
+void	eating_change(t_data *data, int delta)
+{
+	t_eating			*eat;
+	unsigned long long	old;
+	long				now;
+	long				count;
+
+	eat = &data->eating;
+	if (!eat->max)
+		return ;
+	old = atomic_load(&eat->state);
+	while (1)
+	{
+		count = old & EAT_COUNT_MASK;
+		now = get_time_us() - data->start_time;
+		if (now < (long)(old >> EAT_COUNT_BITS))
+			now = old >> EAT_COUNT_BITS;
+		if (count >= eat->max && count + delta < eat->max)
+			atomic_store(&eat->below_since, now);
+		if (atomic_compare_exchange_weak(&eat->state, &old,
+				((unsigned long long)now << EAT_COUNT_BITS) | (count + delta)))
+			break ;
+	}
+	eating_account(eat, count, old >> EAT_COUNT_BITS, now);
+	if (count < eat->max && count + delta >= eat->max)
+		atomic_raise(&eat->below_max, now - atomic_load(&eat->below_since));
+}
+
+/**
+ * @brief Print the eating-concurrency figures of a --stats run.
+ *
+ * The last interval is closed at stop_time. Average and time at the
+ * maximum are weighted by time; the two stretches are the longest
+ * spans with fewer than floor(N/2) philosophers eating, and with
+ * nobody eating at all, i.e. with every fork idle.
+ *
+ * @param data Pointer to the shared data structure, threads joined.
+ */
+void	eating_report(t_data *data)
+{
+	t_eating	*eat;
+	long		last;
+	long		end;
+
+	eat = &data->eating;
+	if (!eat->max)
+		return ;
+	last = atomic_load(&eat->state) >> EAT_COUNT_BITS;
+	end = data->stop_time - data->start_time;
+	if (end < last)
+		end = last;
+	eating_account(eat, atomic_load(&eat->state) & EAT_COUNT_MASK, last, end);
+	if ((long)(atomic_load(&eat->state) & EAT_COUNT_MASK) < eat->max)
+		atomic_raise(&eat->below_max, end - atomic_load(&eat->below_since));
+	if (end < 1)
+		end = 1;
+	fprintf(stderr, "eating_avg %.2f\neating_max %d\n",
+		(double)atomic_load(&eat->area) / end, eat->max);
+	fprintf(stderr, "eating_utilization_pct %.1f\neating_at_max_pct %.1f\n",
+		100.0 * atomic_load(&eat->area) / end / eat->max,
+		100.0 * atomic_load(&eat->at_max) / end);
+	print_ms(stderr, "eating_below_max_ms ", atomic_load(&eat->below_max),
+		"\n");
+	print_ms(stderr, "eating_idle_ms ", atomic_load(&eat->idle_max), "\n");
+}
@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   elastic.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:58:02 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:05:05 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <errno.h>
+
+/**
+ * @brief Size the seat and fork arrays for an elastic ring.
+ *
+ * With --control, the philosophers and forks arrays are allocated for
+ * --capacity seats (twice the initial count by default) so that the
+ * table can grow at runtime without reallocating memory that running
+ * threads point into. Elastic rings cannot be combined with --topology.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 on an invalid combination of options.
+ */
+int	elastic_configure(t_data *data)
+{
+	long	seats;
+
+	data->elastic = (data->opts.control_path != NULL);
+	atomic_init(&data->active_count, data->num_philos);
+	if (!data->elastic)
+		return (0);
+	if (data->opts.topology_path)
+		return (handle_error(ERR_ELASTIC));
+	seats = (long)data->num_philos * 2;
+	if (data->opts.capacity)
+		seats = data->opts.capacity;
+	if (seats < data->num_philos || seats > INT_MAX_VALUE)
+		return (handle_error(ERR_ELASTIC));
+	data->num_seats = (int)seats;
+	data->num_forks = data->num_seats;
+	return (0);
+}
+
+/**
+ * @brief Store a seat's fork pair, lowest index first.
+ *
+ * In an elastic ring every seat owns the fork with its own index (its
+ * left fork) and borrows its successor's. Since the successor changes
+ * as seats come and go, philosophers cannot rely on id parity; the two
+ * forks are taken in global index order instead, through the same
+ * path as --topology rows.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @param left Index of the seat's own fork.
+ * @param right Index of the successor's fork.
+ */
+void	seat_set_forks(t_philo *philo, int left, int right)
+{
+	philo->seat_forks[0] = left;
+	philo->seat_forks[1] = right;
+	if (right < left)
+	{
+		philo->seat_forks[0] = right;
+		philo->seat_forks[1] = left;
+	}
+}
+
+/**
+ * @brief Initialize the elastic-ring state of one seat.
+ *
+ * The first num_philos seats form the initial ring and are active;
+ * the remaining ones are spare until a control command fills them.
+ *
+ * @param philo Pointer to the philosopher structure, data already set.
+ * @param seat Index of the seat in the philosophers array.
+ * @return 0 on success, 1 if the seat mutex could not be created.
+ */
+int	seat_init(t_philo *philo, int seat)
+{
+	int	n;
+
+	n = philo->data->num_philos;
+	atomic_init(&philo->active, seat < n);
+	atomic_init(&philo->leaving, false);
+	philo->joinable = false;
+	philo->remote = false;
+	atomic_init(&philo->bell, 0);
+	atomic_init(&philo->waiting, false);
+	atomic_init(&philo->wait_fork, -1);
+	atomic_init(&philo->misses, 0);
+	if (!philo->data->elastic)
+		return (0);
+	philo->prev = (seat + n - 1) % n;
+	philo->next = (seat + 1) % n;
+	seat_set_forks(philo, seat, philo->next);
+	philo->fork_ids = philo->seat_forks;
+	philo->num_forks = 2;
+	philo->left_fork = NULL;
+	philo->right_fork = NULL;
+	if (pthread_mutex_init(&philo->seat_mutex, NULL))
+		return (handle_error(ERR_INIT_GMUTEX));
+	return (0);
+}
+
+/**
+ * @brief Open the control FIFO and start the control thread.
+ *
+ * The FIFO is created if it does not exist yet. It is opened read-write
+ * so that it never reports end-of-file while no writer is connected.
+ * A self-pipe lets simulation_stop wake the thread out of poll.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success (or without --control), 1 on failure.
+ */
+int	elastic_start(t_data *data)
+{
+	if (!data->elastic)
+		return (0);
+	if (mkfifo(data->opts.control_path, 0600) && errno != EEXIST)
+		return (handle_error(ERR_ELASTIC));
+	data->control.fd = open(data->opts.control_path, O_RDWR | O_NONBLOCK);
+	if (data->control.fd < 0 || pipe(data->control.wake))
+	{
+		elastic_join(data);
+		return (handle_error(ERR_ELASTIC));
+	}
+	data->control.len = 0;
+	if (pthread_create(&data->control.thread, NULL, control_routine, data))
+	{
+		elastic_join(data);
+		return (handle_error(ERR_MONIT_THREAD));
+	}
+	data->control.running = true;
+	return (0);
+}
+
+/**
+ * @brief Wait for the control thread and close the control channel.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	elastic_join(t_data *data)
+{
+	if (data->control.running)
+		pthread_join(data->control.thread, NULL);
+	data->control.running = false;
+	if (data->control.fd >= 0)
+		close(data->control.fd);
+	if (data->control.wake[0] >= 0)
+		close(data->control.wake[0]);
+	if (data->control.wake[1] >= 0)
+		close(data->control.wake[1]);
+	data->control.fd = -1;
+	data->control.wake[0] = -1;
+	data->control.wake[1] = -1;
+}
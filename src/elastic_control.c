@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   elastic_control.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 14:39:27 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 14:39:27 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <poll.h>
+
+/**
+ * @brief Execute one control command.
+ *
+ * Supported commands, one per line:
+ * - "add ID": seat a new philosopher right after philosopher ID.
+ * - "remove ID": remove philosopher ID from the table.
+ * Anything else is reported on stderr and ignored.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param line The command line, without its newline.
+ */
+static void	control_command(t_data *data, char *line)
+{
+	int	status;
+
+	status = 1;
+	if (strncmp(line, "add ", 4) == 0 && is_valid_number(line + 4))
+		status = seat_add(data, ft_atoi(line + 4) - 1);
+	else if (strncmp(line, "remove ", 7) == 0 && is_valid_number(line + 7))
+		status = seat_remove(data, ft_atoi(line + 7) - 1);
+	if (status)
+	{
+		pthread_mutex_lock(&data->print_mutex);
+		fprintf(stderr, "control: ignored \"%s\"\n", line);
+		pthread_mutex_unlock(&data->print_mutex);
+	}
+}
+
+/**
+ * @brief Read pending bytes from the FIFO and run every complete line.
+ *
+ * A line longer than the buffer is discarded.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+static void	control_read(t_data *data)
+{
+	t_control	*ctl;
+	ssize_t		bytes;
+	char		*newline;
+
+	ctl = &data->control;
+	bytes = read(ctl->fd, ctl->buf + ctl->len, CONTROL_BUF_SIZE - 1 - ctl->len);
+	if (bytes <= 0)
+		return ;
+	ctl->len += bytes;
+	ctl->buf[ctl->len] = '\0';
+	newline = strchr(ctl->buf, '\n');
+	while (newline)
+	{
+		*newline = '\0';
+		control_command(data, ctl->buf);
+		ctl->len -= newline + 1 - ctl->buf;
+		memmove(ctl->buf, newline + 1, ctl->len + 1);
+		newline = strchr(ctl->buf, '\n');
+	}
+	if (ctl->len == CONTROL_BUF_SIZE - 1)
+		ctl->len = 0;
+}
+
+/**
+ * @brief Control thread: apply scaling commands until the end.
+ *
+ * Blocks in poll on the control FIFO and on the wake-up pipe, which
+ * simulation_stop writes to, so the thread exits as soon as the
+ * simulation stops.
+ *
+ * @param arg Pointer to the shared data structure cast as void*.
+ * @return Always returns NULL when the simulation ends.
+ */
+void	*control_routine(void *arg)
+{
+	t_data			*data;
+	struct pollfd	pfd[2];
+
+	data = (t_data *)arg;
+	pfd[0].fd = data->control.fd;
+	pfd[0].events = POLLIN;
+	pfd[1].fd = data->control.wake[0];
+	pfd[1].events = POLLIN;
+	while (!simulation_over(data))
+	{
+		if (poll(pfd, 2, -1) > 0 && (pfd[0].revents & POLLIN))
+			control_read(data);
+	}
+	return (NULL);
+}
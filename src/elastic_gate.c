@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   elastic_gate.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 14:28:03 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Report a scaling event on stderr.
+ *
+ * Scaling events go to stderr so the simulation log on stdout keeps its
+ * usual format. The line carries the new table size and the number of
+ * meals eaten so far, to correlate throughput with scaling events.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param seat Index of the seat that joined or left.
+ * @param event Description of the event.
+ */
+void	seat_event(t_data *data, int seat, char *event)
+{
+	long	meals;
+
+	pthread_mutex_lock(&data->meal_mutex);
+	meals = data->meals_total;
+	pthread_mutex_unlock(&data->meal_mutex);
+	pthread_mutex_lock(&data->print_mutex);
+	fprintf(stderr, "%ld %d %s (table %d, meals %ld)\n",
+		(get_time_us() - data->start_time) / 1000, seat + 1, event,
+		atomic_load(&data->active_count), meals);
+	pthread_mutex_unlock(&data->print_mutex);
+}
+
+/**
+ * @brief Give a newcomer a fresh meal time before its thread starts.
+ *
+ * Called before the newcomer's thread exists; the meal mutex protects
+ * the fields against the monitor, which may already see the seat.
+ *
+ * @param seat Pointer to the newcomer, already linked into the ring.
+ */
+void	seat_gate(t_philo *seat)
+{
+	pthread_mutex_lock(&seat->data->meal_mutex);
+	seat->meals_eaten = 0;
+	seat->last_meal_time = get_time_us();
+	pthread_mutex_unlock(&seat->data->meal_mutex);
+}
+
+/**
+ * @brief Reset the control channel: no FIFO, no wake-up pipe, no thread.
+ *
+ * @param control Pointer to the control channel.
+ */
+void	control_init(t_control *control)
+{
+	control->fd = -1;
+	control->wake[0] = -1;
+	control->wake[1] = -1;
+	control->running = false;
+}
@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   elastic_seats.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 14:16:51 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:11:12 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Find a free seat in the preallocated philosophers array.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return Index of a free seat, or -1 if the table is at capacity.
+ */
+static int	free_seat(t_data *data)
+{
+	int	i;
+
+	i = 0;
+	while (i < data->num_seats)
+	{
+		if (!atomic_load(&data->philos[i].active)
+			&& !data->philos[i].joinable)
+			return (i);
+		i++;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Insert a seat into the ring right after another one.
+ *
+ * The new seat brings its own fork and borrows the fork of its
+ * successor. Only the predecessor has to switch its right fork; this
+ * is done under the predecessor's seat mutex, which the predecessor
+ * holds from taking its forks until releasing them, so the switch
+ * simply waits for the end of its current meal.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param after Index of the predecessor seat.
+ * @param slot Index of the seat being inserted.
+ */
+static void	seat_link(t_data *data, int after, int slot)
+{
+	t_philo	*pred;
+	t_philo	*seat;
+
+	pred = &data->philos[after];
+	seat = &data->philos[slot];
+	seat_set_forks(seat, slot, pred->next);
+	pthread_mutex_lock(&pred->seat_mutex);
+	seat_set_forks(pred, after, slot);
+	pthread_mutex_unlock(&pred->seat_mutex);
+	pthread_mutex_lock(&data->meal_mutex);
+	seat->prev = after;
+	seat->next = pred->next;
+	data->philos[pred->next].prev = slot;
+	pred->next = slot;
+	pthread_mutex_unlock(&data->meal_mutex);
+}
+
+/**
+ * @brief Take a seat out of the ring.
+ *
+ * The predecessor takes over the removed seat's right fork under its
+ * own seat mutex. The removed seat must not be running any more.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param seat Index of the seat being removed.
+ */
+static void	seat_unlink(t_data *data, int seat)
+{
+	t_philo	*philo;
+	t_philo	*pred;
+
+	philo = &data->philos[seat];
+	pred = &data->philos[philo->prev];
+	pthread_mutex_lock(&pred->seat_mutex);
+	seat_set_forks(pred, philo->prev, philo->next);
+	pthread_mutex_unlock(&pred->seat_mutex);
+	pthread_mutex_lock(&data->meal_mutex);
+	pred->next = philo->next;
+	data->philos[philo->next].prev = philo->prev;
+	pthread_mutex_unlock(&data->meal_mutex);
+}
+
+/**
+ * @brief Seat a new philosopher right after an existing one.
+ *
+ * The rest of the ring keeps running while the seat is linked in. The
+ * newcomer starts with a fresh meal time, so it lets both neighbors,
+ * which may already be hungry, eat before it (see philo_yield). If
+ * its thread cannot be created, the seat is unlinked again.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param after Index of the seat to insert after.
+ * @return 0 on success, 1 if the seat is invalid or the table is full.
+ */
+int	seat_add(t_data *data, int after)
+{
+	t_philo	*seat;
+	int		slot;
+
+	slot = free_seat(data);
+	if (slot < 0 || after < 0 || after >= data->num_seats
+		|| !atomic_load(&data->philos[after].active))
+		return (1);
+	seat = &data->philos[slot];
+	seat_link(data, after, slot);
+	seat_gate(seat);
+	atomic_store(&seat->leaving, false);
+	if (pthread_create(&seat->thread, NULL, philo_routine, seat))
+	{
+		seat_unlink(data, slot);
+		return (1);
+	}
+	rt_promote(data, seat->thread, data->opts.rt_philo);
+	seat->joinable = true;
+	atomic_store(&seat->active, true);
+	atomic_fetch_add(&data->active_count, 1);
+	seat_event(data, slot, "joined the table");
+	return (0);
+}
+
+/**
+ * @brief Remove a philosopher from the ring.
+ *
+ * The philosopher is asked to leave and finishes its current cycle
+ * first, so it never leaves while holding forks. Once its thread is
+ * joined, the seat is unlinked. The table never shrinks below two.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param seat Index of the seat to remove.
+ * @return 0 on success, 1 if the seat is invalid or the table too small.
+ */
+int	seat_remove(t_data *data, int seat)
+{
+	t_philo	*philo;
+
+	if (seat < 0 || seat >= data->num_seats
+		|| atomic_load(&data->active_count) <= 2
+		|| !atomic_load(&data->philos[seat].active))
+		return (1);
+	philo = &data->philos[seat];
+	atomic_store(&philo->leaving, true);
+	if (philo->joinable)
+		pthread_join(philo->thread, NULL);
+	philo->joinable = false;
+	atomic_store(&philo->active, false);
+	seat_unlink(data, seat);
+	atomic_fetch_sub(&data->active_count, 1);
+	seat_event(data, seat, "left the table");
+	return (0);
+}
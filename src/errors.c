@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   errors.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:51 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:51 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Look up the message of an error code.
+ *
+ * @param error An error code from the t_error enum, below ERR_COUNT.
+ * @return The message, followed by a newline.
+ */
+static const char	*error_message(t_error error)
+{
+	static const char	*messages[] = {
+		NULL, "Error\nInvalid number of arguments\n",
+		"Error\nArgument must be numeric only\n",
+		"Error\nArgument must be a positive integer\n",
+		"Error\nValue exceeds maximum (2147483647)\n",
+		"Error\nOne philosopher cannot eat (needs at least 2)\n",
+		"Error\nFailed to initialize global mutex\n",
+		"Error\nFailed to initialize fork mutex\n",
+		"Error\nMemory allocation failed\n",
+		"Error\nFailed to create philosopher thread\n",
+		"Error\nFailed to create monitor thread\n",
+		"Error\nUnknown or malformed option\n",
+		"Error\nInvalid schedule file or --record/--replay combination\n",
+		"Error\nInvalid topology file\n",
+		"Error\nInvalid --control/--capacity configuration\n",
+		"Error\nInvalid --nodes value or combination\n",
+		"Error\n--forks=bitmap needs the plain ring\n",
+		"Error\n--plan needs the plain ring, without record or replay\n",
+		"Error\nInvalid --rt priority for this policy\n",
+		"Error\n--perf needs a single process, without --nodes\n",
+		"Error\n--timetable needs the plain ring of at least 2\n",
+		"Error\ntime_to_die is too short for the --timetable schedule\n"
+	};
+
+	return (messages[error]);
+}
+
+/**
+ * @brief Handle and display error messages.
+ *
+ * This function takes an error code from the t_error enum and displays
+ * the corresponding error message to the standard output, looked up
+ * by error_message. The function always returns 1 to indicate an
+ * error occurred.
+ *
+ * @param error The error code from the t_error enum indicating the
+ *              type of error.
+ * @return Always returns 1 to indicate an error condition.
+ */
+int	handle_error(t_error error)
+{
+	if (error > 0 && error < ERR_COUNT)
+		printf("%s", error_message(error));
+	return (1);
+}
@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fairness.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 22:51:06 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 22:51:06 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Check whether another philosopher is hungrier.
+ *
+ * The other philosopher is hungrier if its last meal is strictly
+ * older; on a tie (at the start of the simulation) nobody yields.
+ * Must be called with the meal mutex held.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @param other Pointer to a philosopher sharing one of its forks.
+ * @return true if the philosopher should let the other one eat first.
+ */
+static bool	hungrier(t_philo *philo, t_philo *other)
+{
+	if (other == philo || !atomic_load(&other->active))
+		return (false);
+	return (other->last_meal_time < philo->last_meal_time);
+}
+
+/**
+ * @brief Look for a hungrier philosopher sharing one of our forks.
+ *
+ * In an elastic ring the sharers are the two neighbors. On a
+ * --topology graph they are the members of each of the philosopher's
+ * forks, found through the fork-major rows of the graph. Must be
+ * called with the meal mutex held.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @return true if some sharer is hungrier.
+ */
+static bool	sharer_hungrier(t_philo *philo)
+{
+	t_data	*data;
+	int		i;
+	int		j;
+
+	data = philo->data;
+	if (data->elastic)
+		return (hungrier(philo, &data->philos[philo->prev])
+			|| hungrier(philo, &data->philos[philo->next]));
+	i = 0;
+	while (i < philo->num_forks)
+	{
+		j = data->fork_offsets[philo->fork_ids[i]];
+		while (j < data->fork_offsets[philo->fork_ids[i] + 1])
+		{
+			if (hungrier(philo, &data->philos[data->fork_philos[j]]))
+				return (true);
+			j++;
+		}
+		i++;
+	}
+	return (false);
+}
+
+/**
+ * @brief Let hungrier philosophers take the shared forks first.
+ *
+ * Id parity and the odd-count think delay only keep the classic ring
+ * fair. On a --topology graph, or in an elastic ring whose fork pairs
+ * change at runtime, a philosopher instead does not queue for its
+ * forks while a philosopher sharing one of them has a strictly older
+ * last meal. A newcomer to an elastic ring, whose meal time is fresh,
+ * thus lets its hungry neighbors eat first. The hungriest philosopher
+ * never yields, so the wait always ends.
+ *
+ * @param philo Pointer to the philosopher structure.
+ */
+void	philo_yield(t_philo *philo)
+{
+	t_data	*data;
+	bool	yield;
+
+	data = philo->data;
+	while (!simulation_over(data))
+	{
+		pthread_mutex_lock(&data->meal_mutex);
+		yield = sharer_hungrier(philo);
+		pthread_mutex_unlock(&data->meal_mutex);
+		if (!yield)
+			return ;
+		futex_wait(&data->stop, 0, 100);
+	}
+}
@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   forks.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 12:34:18 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:20:21 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include "probes.h"
+
+/**
+ * @brief Initialize a fork: its mutex and its wake-up counters.
+ *
+ * @param fork Pointer to the fork to initialize.
+ * @return 0 on success, non-zero if the mutex could not be created.
+ */
+int	fork_init(t_fork *fork)
+{
+	atomic_init(&fork->gen, 0);
+	atomic_init(&fork->waiters, 0);
+	atomic_init(&fork->owner, -1);
+	return (pthread_mutex_init(&fork->mutex, NULL));
+}
+
+/**
+ * @brief Wait for a contended fork, giving up when the simulation stops.
+ *
+ * A plain pthread_mutex_lock cannot be interrupted, so a philosopher
+ * blocked on a fork would only see the end of the simulation once the
+ * fork is released. Instead the waiter registers itself and sleeps on
+ * the fork's generation counter, which is bumped both by fork_unlock
+ * and by simulation_stop. The generation is sampled before retrying
+ * the lock, so a release happening in between makes futex_wait return
+ * at once. Every failed retry counts as a miss for the detector.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param fork Pointer to the fork to take.
+ * @param who Index of the waiting philosopher, or FORK_REMOTE.
+ * @return true if the fork was taken, false if the simulation stopped.
+ */
+static bool	fork_wait(t_data *data, t_fork *fork, int who)
+{
+	int		gen;
+	bool	taken;
+
+	while (1)
+	{
+		gen = atomic_load(&fork->gen);
+		atomic_fetch_add(&fork->waiters, 1);
+		taken = (pthread_mutex_trylock(&fork->mutex) == 0);
+		if (taken || atomic_load(&data->stop))
+		{
+			atomic_fetch_sub(&fork->waiters, 1);
+			return (taken);
+		}
+		if (who >= 0)
+			atomic_fetch_add_explicit(&data->philos[who].misses, 1,
+				memory_order_relaxed);
+		futex_wait(&fork->gen, gen, -1);
+		atomic_fetch_sub(&fork->waiters, 1);
+	}
+}
+
+/**
+ * @brief Take a fork, giving up as soon as the simulation stops.
+ *
+ * A free fork is taken with a single trylock, which costs the same
+ * compare-and-swap as an uncontended pthread_mutex_lock, plus one
+ * relaxed store publishing the new owner. Only a contended fork takes
+ * the slow path, during which the philosopher also publishes the fork
+ * it waits for; the deadlock detector reads both.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param fork Pointer to the fork to take.
+ * @param who Index of the philosopher taking it, or FORK_REMOTE.
+ * @return true if the fork was taken, false if the simulation stopped.
+ */
+bool	fork_lock(t_data *data, t_fork *fork, int who)
+{
+	bool	taken;
+
+	if (pthread_mutex_trylock(&fork->mutex) != 0)
+	{
+		if (who >= 0)
+			atomic_store_explicit(&data->philos[who].wait_fork,
+				fork - data->forks, memory_order_relaxed);
+		taken = fork_wait(data, fork, who);
+		if (who >= 0)
+			atomic_store_explicit(&data->philos[who].wait_fork, -1,
+				memory_order_relaxed);
+		if (!taken)
+			return (false);
+	}
+	atomic_store_explicit(&fork->owner, who, memory_order_relaxed);
+	PROBE3(fork_taken, who + 1, fork - data->forks, get_time_us());
+	return (true);
+}
+
+/**
+ * @brief Release a fork and wake the philosophers waiting for it.
+ *
+ * Without registered waiters this is a plain unlock plus one load.
+ * Otherwise every waiter is woken: on a --topology graph a fork may
+ * have several, and the one that would win the lock may be one that
+ * is giving up because the simulation stopped.
+ *
+ * @param fork Pointer to the fork to release.
+ */
+void	fork_unlock(t_fork *fork)
+{
+	atomic_store_explicit(&fork->owner, -1, memory_order_relaxed);
+	pthread_mutex_unlock(&fork->mutex);
+	if (atomic_load(&fork->waiters) > 0)
+	{
+		atomic_fetch_add(&fork->gen, 1);
+		futex_wake(&fork->gen, INT_MAX_VALUE);
+	}
+}
+
+/**
+ * @brief Take two ring forks in the given order.
+ *
+ * A philosopher waiting for the second fork gives up, and puts back
+ * the first one, when the simulation stops.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @param first The fork to take first.
+ * @param second The fork to take second.
+ * @return true if both forks were taken, false if the simulation stopped.
+ */
+bool	fork_take_pair(t_philo *philo, t_fork *first, t_fork *second)
+{
+	if (!fork_lock(philo->data, first, philo->id - 1))
+		return (false);
+	print_status(philo, "has taken a fork");
+	if (!fork_lock(philo->data, second, philo->id - 1))
+	{
+		fork_unlock(first);
+		return (false);
+	}
+	print_status(philo, "has taken a fork");
+	return (true);
+}
@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   futex.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 12:21:30 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+#ifdef __linux__
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <sys/prctl.h>
+
+/**
+ * @brief Block while *addr still holds the expected value.
+ *
+ * Returns immediately if the word already changed, when another thread
+ * calls futex_wake on it, or once the timeout expires. Spurious
+ * returns are possible, so callers always re-check their condition.
+ *
+ * @param addr The futex word.
+ * @param expected The value the caller last observed in *addr.
+ * @param timeout_us Maximum wait in microseconds, or -1 for no limit.
+ */
+void	futex_wait(atomic_int *addr, int expected, long timeout_us)
+{
+	struct timespec	timeout;
+
+	if (timeout_us < 0)
+	{
+		syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+		return ;
+	}
+	timeout.tv_sec = timeout_us / 1000000;
+	timeout.tv_nsec = (timeout_us % 1000000) * 1000;
+	syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, &timeout, NULL, 0);
+}
+
+/**
+ * @brief Wake up to count threads blocked in futex_wait on addr.
+ *
+ * @param addr The futex word.
+ * @param count Maximum number of waiters to wake (INT_MAX_VALUE: all).
+ */
+void	futex_wake(atomic_int *addr, int count)
+{
+	syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+/**
+ * @brief Tighten the timer slack for sub-millisecond phases.
+ *
+ * A timed futex wait may otherwise end up to 50 us late: noise next to
+ * a 200 ms meal, but several times a 10 us one. Threads inherit the
+ * slack of the thread that creates them, so this is called before the
+ * philosophers are started.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	timer_tighten(t_data *data)
+{
+	if (data->time_to_eat < 1000 || data->time_to_sleep < 1000)
+		prctl(PR_SET_TIMERSLACK, 1UL);
+}
+
+#else
+
+/**
+ * @brief Portable fallback: sleep one short interval and let the caller
+ *        re-check its condition, as precise_sleep used to do.
+ */
+void	futex_wait(atomic_int *addr, int expected, long timeout_us)
+{
+	if (atomic_load(addr) != expected)
+		return ;
+	if (timeout_us < 0 || timeout_us > SLEEP_CHECK_INTERVAL)
+		timeout_us = SLEEP_CHECK_INTERVAL;
+	usleep(timeout_us);
+}
+
+/**
+ * @brief Portable fallback: waiters poll, so there is nothing to wake.
+ */
+void	futex_wake(atomic_int *addr, int count)
+{
+	(void)addr;
+	(void)count;
+}
+
+/**
+ * @brief Portable fallback: the timer slack is left as it is.
+ */
+void	timer_tighten(t_data *data)
+{
+	(void)data;
+}
+
+#endif
@@ -6,21 +6,56 @@
 /*   By: maria-ol <maria-ol@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/07 13:45:44 by mona              #+#    #+#             */
-/*   Updated: 2026/01/09 16:05:22 by maria-ol         ###   ########.fr       */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philosophers.h"
 
+/**
+ * @brief Reset the runtime state of the shared data structure.
+ *
+ * Clears the control flags and statistics and sets every pointer field
+ * to NULL, so that cleanup is safe whichever initialization step fails.
+ *
+ * @param data Pointer to the data structure to be initialized.
+ */
+static void	init_runtime(t_data *data)
+{
+	data->someone_died = false;
+	data->all_ate_enough = false;
+	atomic_init(&data->stop, 0);
+	stats_init(data);
+	data->philos = NULL;
+	data->forks = NULL;
+	data->fork_bits = NULL;
+	data->num_seats = data->num_philos;
+	data->num_forks = data->num_philos;
+	data->topo_offsets = NULL;
+	data->topo_forks = NULL;
+	data->fork_offsets = NULL;
+	data->fork_philos = NULL;
+	data->sched.cycles = NULL;
+	data->sched.initialized = false;
+	data->elastic = false;
+	control_init(&data->control);
+	node_init(&data->node);
+	data->detect.running = false;
+	data->detect.mark = NULL;
+	data->detect.flagged = NULL;
+	atomic_init(&data->rt_denied, false);
+}
+
 /**
  * @brief Initialize the shared data structure.
  *
  * This function parses command-line arguments and initializes the
  * shared data structure with simulation parameters. It sets the
  * number of philosophers, timing values (time_to_die, time_to_eat,
- * time_to_sleep), and optionally the minimum number of meals each
- * philosopher must eat. It also initializes control flags and sets
- * pointer fields to NULL.
+ * time_to_sleep, converted to microseconds), and optionally the
+ * minimum number of meals each philosopher must eat. The monitor
+ * checks at least ten times per time_to_die. It also initializes
+ * control flags and sets pointer fields to NULL.
  *
  * @param data Pointer to the data structure to be initialized.
  * @param ac Number of command-line arguments.
@@ -30,27 +65,27 @@
 int	init_data(t_data *data, int ac, char **av)
 {
 	data->num_philos = ft_atoi(av[1]);
-	data->time_to_die = ft_atoi(av[2]);
-	data->time_to_eat = ft_atoi(av[3]);
-	data->time_to_sleep = ft_atoi(av[4]);
+	data->time_to_die = ft_atol(av[2]) * duration_scale(av[2]);
+	data->time_to_eat = ft_atol(av[3]) * duration_scale(av[3]);
+	data->time_to_sleep = ft_atol(av[4]) * duration_scale(av[4]);
 	if (ac == 6)
 		data->num_must_eat = ft_atoi(av[5]);
 	else
 		data->num_must_eat = -1;
-	data->someone_died = false;
-	data->all_ate_enough = false;
-	data->philos = NULL;
-	data->forks = NULL;
+	data->monitor_interval = MONITOR_CHECK_INTERVAL;
+	if (data->time_to_die / 10 < data->monitor_interval)
+		data->monitor_interval = data->time_to_die / 10;
+	init_runtime(data);
 	return (0);
 }
 
 /**
  * @brief Initialize all mutexes for the simulation.
  *
- * This function creates and initializes all mutexes required for the
- * simulation. It initializes three global mutexes (print_mutex,
- * death_mutex, meal_mutex) and allocates an array of fork mutexes,
- * one for each philosopher. Each fork mutex is then initialized.
+ * This function creates and initializes the three global mutexes
+ * (print_mutex, death_mutex, meal_mutex). It runs before anything
+ * else can fail, so cleanup always finds them initialized. The fork
+ * mutexes are created by init_forks once the fork count is known.
  * Returns an error code if any initialization fails.
  *
  * @param data Pointer to the shared data structure where mutexes
@@ -59,21 +94,36 @@ int	init_data(t_data *data, int ac, char **av)
  */
 int	init_mutexes(t_data *data)
 {
-	int	i;
-
 	if (pthread_mutex_init(&data->print_mutex, NULL))
 		return (handle_error(ERR_INIT_GMUTEX));
 	if (pthread_mutex_init(&data->death_mutex, NULL))
 		return (handle_error(ERR_INIT_GMUTEX));
 	if (pthread_mutex_init(&data->meal_mutex, NULL))
 		return (handle_error(ERR_INIT_GMUTEX));
-	data->forks = malloc(sizeof(pthread_mutex_t) * data->num_philos);
+	return (0);
+}
+
+/**
+ * @brief Allocate and initialize the forks.
+ *
+ * This function allocates an array of forks, one for each
+ * philosopher (or one per fork of the --topology graph, or one per
+ * seat of an elastic ring), and initializes each fork mutex.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 on failure.
+ */
+int	init_forks(t_data *data)
+{
+	int	i;
+
+	data->forks = malloc(sizeof(t_fork) * data->num_forks);
 	if (!data->forks)
 		return (handle_error(ERR_ALOC));
 	i = 0;
-	while (i < data->num_philos)
+	while (i < data->num_forks)
 	{
-		if (pthread_mutex_init(&data->forks[i], NULL))
+		if (fork_init(&data->forks[i]))
 			return (handle_error(ERR_INIT_FMUTEX));
 		i++;
 	}
@@ -85,10 +135,11 @@ int	init_mutexes(t_data *data)
  *
  * This function allocates memory for the philosophers array and
  * initializes each philosopher structure. It assigns a unique ID,
- * sets initial meal count to 0, assigns left and right fork pointers
- * using circular indexing, and links each philosopher to the shared
- * data structure. The right fork uses modulo arithmetic to wrap
- * around for the last philosopher.
+ * sets initial meal count to 0, links each philosopher to the shared
+ * data structure and lets topology_assign pick its forks: left and
+ * right fork pointers using circular indexing, or its row of the
+ * conflict graph with --topology. With
+ * --control, spare seats are allocated up to the ring's capacity.
  *
  * @param data Pointer to the shared data structure containing
  *             philosopher array to be initialized.
@@ -98,18 +149,21 @@ int	init_philos(t_data *data)
 {
 	int	i;
 
-	data->philos = malloc(sizeof(t_philo) * data->num_philos);
+	data->philos = malloc(sizeof(t_philo) * data->num_seats);
 	if (!data->philos)
 		return (handle_error(ERR_ALOC));
 	i = 0;
-	while (i < data->num_philos)
+	while (i < data->num_seats)
 	{
 		data->philos[i].id = i + 1;
 		data->philos[i].meals_eaten = 0;
 		data->philos[i].last_meal_time = 0;
-		data->philos[i].left_fork = &data->forks[i];
-		data->philos[i].right_fork = &data->forks[(i + 1) % data->num_philos];
+		data->philos[i].cycle = -1;
+		data->philos[i].next_cycle = -1;
 		data->philos[i].data = data;
+		topology_assign(&data->philos[i]);
+		if (seat_init(&data->philos[i], i))
+			return (1);
 		i++;
 	}
 	return (0);
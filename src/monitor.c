@@ -6,11 +6,69 @@
 /*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/09 15:46:13 by maria-ol          #+#    #+#             */
-/*   Updated: 2026/01/12 19:50:43 by mona             ###   ########.fr       */
+/*   Updated: 2026/10/18 23:23:34 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philosophers.h"
+#include "probes.h"
+
+/**
+ * @brief Check a single seat for starvation.
+ *
+ * Empty seats of an elastic ring are skipped. The smallest remaining
+ * margin before time_to_die seen so far is kept for --stats.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param i Index of the seat to check.
+ * @return The time of the check if the philosopher died, 0 otherwise.
+ */
+static long	philo_died(t_data *data, int i)
+{
+	long	last_meal;
+	long	current_time;
+
+	if (!atomic_load(&data->philos[i].active))
+		return (0);
+	current_time = get_time_us();
+	pthread_mutex_lock(&data->meal_mutex);
+	last_meal = data->philos[i].last_meal_time;
+	pthread_mutex_unlock(&data->meal_mutex);
+	if (data->time_to_die - (current_time - last_meal) < data->min_slack)
+		data->min_slack = data->time_to_die - (current_time - last_meal);
+	PROBE3(check, i + 1, data->time_to_die - (current_time - last_meal),
+		current_time);
+	if ((current_time - last_meal) >= data->time_to_die)
+		return (current_time);
+	return (0);
+}
+
+/**
+ * @brief Flag a death, print it and stop the simulation.
+ *
+ * A --nodes process sends the death to the coordinator, which prints
+ * it, instead of printing it itself.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param i Index of the seat that died.
+ * @param current_time Time at which the death was detected.
+ */
+static void	announce_death(t_data *data, int i, long current_time)
+{
+	pthread_mutex_lock(&data->death_mutex);
+	data->someone_died = true;
+	pthread_mutex_unlock(&data->death_mutex);
+	PROBE2(death, data->philos[i].id, current_time);
+	pthread_mutex_lock(&data->print_mutex);
+	if (data->node.index >= 0)
+		node_print(data, data->philos[i].id, "died",
+			(current_time - data->start_time) / 1000);
+	else
+		printf("%ld %d died\n", (current_time - data->start_time) / 1000,
+			data->philos[i].id);
+	pthread_mutex_unlock(&data->print_mutex);
+	simulation_stop(data);
+}
 
 /**
  * @brief Check if any philosopher has died from starvation.
@@ -18,7 +76,8 @@
  * This function iterates through all philosophers and checks if any
  * has exceeded the time_to_die limit since their last meal. If a
  * philosopher is found to have died, it sets the someone_died flag,
- * prints the death message with proper timestamp, and returns true.
+ * prints the death message with proper timestamp, wakes every
+ * blocked philosopher through simulation_stop, and returns true.
  * Access to shared data is protected by appropriate mutexes.
  *
  * @param data Pointer to the shared data structure.
@@ -26,26 +85,16 @@
  */
 bool	check_death(t_data *data)
 {
-	long	last_meal;
 	long	current_time;
 	int		i;
 
 	i = 0;
-	while (i < data->num_philos)
+	while (i < data->num_seats)
 	{
-		current_time = get_time();
-		pthread_mutex_lock(&data->meal_mutex);
-		last_meal = data->philos[i].last_meal_time;
-		pthread_mutex_unlock(&data->meal_mutex);
-		if ((current_time - last_meal) >= data->time_to_die)
+		current_time = philo_died(data, i);
+		if (current_time)
 		{
-			pthread_mutex_lock(&data->death_mutex);
-			data->someone_died = true;
-			pthread_mutex_unlock(&data->death_mutex);
-			pthread_mutex_lock(&data->print_mutex);
-			printf("%ld %d died\n", current_time - data->start_time,
-				data->philos[i].id);
-			pthread_mutex_unlock(&data->print_mutex);
+			announce_death(data, i, current_time);
 			return (true);
 		}
 		i++;
@@ -57,10 +106,12 @@ bool	check_death(t_data *data)
  * @brief Check if all philosophers have eaten enough times.
  *
  * This function verifies if all philosophers have reached the
- * required number of meals (num_must_eat). If num_must_eat is -1,
+ * required number of meals (num_must_eat), counting the seated
+ * philosophers that are still hungry. If num_must_eat is -1,
  * the function returns false immediately as there is no meal limit.
  * If all philosophers have eaten the required amount, it sets the
- * all_ate_enough flag and returns true.
+ * all_ate_enough flag, stops the simulation and returns true. A
+ * --nodes process only tells the coordinator and keeps running.
  *
  * @param data Pointer to the shared data structure.
  * @return true if all philosophers ate enough, false otherwise.
@@ -69,29 +120,29 @@ bool	check_all_ate(t_data *data)
 {
 	int		i;
 	int		count;
-	int		meals;
 
 	if (data->num_must_eat == -1)
 		return (false);
 	i = 0;
 	count = 0;
-	while (i < data->num_philos)
+	while (i < data->num_seats)
 	{
 		pthread_mutex_lock(&data->meal_mutex);
-		meals = data->philos[i].meals_eaten;
-		pthread_mutex_unlock(&data->meal_mutex);
-		if (meals >= data->num_must_eat)
+		if (data->philos[i].meals_eaten < data->num_must_eat
+			&& atomic_load(&data->philos[i].active))
 			count++;
+		pthread_mutex_unlock(&data->meal_mutex);
 		i++;
 	}
-	if (count == data->num_philos)
-	{
-		pthread_mutex_lock(&data->death_mutex);
-		data->all_ate_enough = true;
-		pthread_mutex_unlock(&data->death_mutex);
-		return (true);
-	}
-	return (false);
+	if (count != 0)
+		return (false);
+	if (data->node.index >= 0)
+		return (node_done(data));
+	pthread_mutex_lock(&data->death_mutex);
+	data->all_ate_enough = true;
+	pthread_mutex_unlock(&data->death_mutex);
+	simulation_stop(data);
+	return (true);
 }
 
 /**
@@ -100,8 +151,11 @@ bool	check_all_ate(t_data *data)
  * This function runs in a separate thread and continuously monitors
  * the simulation state. It checks if any philosopher has died from
  * starvation or if all philosophers have eaten the required number
- * of meals. The loop exits when either condition is met. Small
- * delays are introduced to reduce CPU usage during monitoring.
+ * of meals. The loop exits when either condition is met, or when the
+ * simulation was stopped for another reason. Small
+ * delays are introduced to reduce CPU usage during monitoring; they
+ * shrink with time_to_die so that sub-millisecond deadlines are kept.
+ * With --perf, the thread's own counters are collected.
  *
  * @param arg Pointer to the shared data structure cast as void*.
  * @return Always returns NULL when monitoring ends.
@@ -109,15 +163,18 @@ bool	check_all_ate(t_data *data)
 void	*monitor_routine(void *arg)
 {
 	t_data	*data;
+	t_perf	perf;
 
 	data = (t_data *)arg;
-	while (1)
+	perf_begin(data, &perf);
+	while (!simulation_over(data))
 	{
 		if (check_death(data) == true)
 			break ;
 		if (check_all_ate(data) == true)
 			break ;
-		usleep(MONITOR_CHECK_INTERVAL);
+		usleep(data->monitor_interval);
 	}
+	perf_end(data, &perf, PERF_MONITOR);
 	return (NULL);
 }
@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   node.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:14:40 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <sys/socket.h>
+
+/**
+ * @brief Reset the distributed-ring state: not distributed, no sockets.
+ *
+ * @param node Pointer to the node state to reset.
+ */
+void	node_init(t_node *node)
+{
+	memset(node, 0, sizeof(t_node));
+	node->index = -1;
+	node->coord = -1;
+	node->client.fd = -1;
+	node->server.fd = -1;
+	node->detect_us = -1;
+}
+
+/**
+ * @brief Check and size a distributed ring.
+ *
+ * With --nodes=K the ring is split into K contiguous segments, each
+ * run by its own process. Every segment needs at least one philosopher,
+ * and the other engines (--topology, --control, --record, --replay)
+ * rely on shared memory, so they cannot be combined with it.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success (or without --nodes), 1 on failure.
+ */
+int	nodes_configure(t_data *data)
+{
+	if (!data->opts.nodes)
+		return (0);
+	if (data->opts.nodes < 2 || data->opts.nodes > data->num_philos
+		|| data->opts.topology_path || data->elastic
+		|| data->opts.record_path || data->opts.replay_path)
+		return (handle_error(ERR_NODES));
+	data->node.count = (int)data->opts.nodes;
+	data->node.polls = malloc(sizeof(struct pollfd) * data->node.count);
+	data->node.pids = malloc(sizeof(pid_t) * data->node.count);
+	if (!data->node.polls || !data->node.pids)
+		return (handle_error(ERR_ALOC));
+	return (0);
+}
+
+/**
+ * @brief Create every socket pair before any node is forked.
+ *
+ * Pairs 0..K-1 connect the coordinator (end 0, polled) to node k
+ * (end 1). Pairs K..2K-1 are the ring links: link k connects node k
+ * (end 0, the client borrowing the boundary fork) to node k + 1
+ * (end 1, the server lending it). SOCK_SEQPACKET keeps each message
+ * whole.
+ *
+ * @param data Pointer to the coordinator's data structure.
+ * @return The 2K socket pairs, or NULL on failure (nothing left open).
+ */
+static void	*open_pairs(t_data *data)
+{
+	int	(*pairs)[2];
+	int	i;
+
+	pairs = malloc(sizeof(*pairs) * data->node.count * 2);
+	i = 0;
+	while (pairs && i < data->node.count * 2)
+	{
+		if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, pairs[i]))
+		{
+			while (i-- > 0)
+			{
+				close(pairs[i][0]);
+				close(pairs[i][1]);
+			}
+			free(pairs);
+			return (NULL);
+		}
+		if (i < data->node.count)
+		{
+			data->node.polls[i].fd = pairs[i][0];
+			data->node.polls[i].events = POLLIN;
+		}
+		i++;
+	}
+	return (pairs);
+}
+
+/**
+ * @brief Body of a node process: run one segment, then exit.
+ *
+ * The node keeps its coordinator socket, the client end of its own
+ * link and the server end of its predecessor's link, and closes every
+ * other descriptor inherited from the coordinator.
+ *
+ * @param data Pointer to the node's copy of the shared data.
+ * @param pairs The socket pairs created by open_pairs.
+ * @param k Index of the node.
+ */
+static void	run_node(t_data *data, int (*pairs)[2], int k)
+{
+	t_node	*node;
+	int		i;
+	int		fd;
+	int		status;
+
+	node = &data->node;
+	node->coord = pairs[k][1];
+	node->client.fd = pairs[node->count + k][0];
+	node->server.fd = pairs[node->count
+		+ (k + node->count - 1) % node->count][1];
+	i = 0;
+	while (i < node->count * 4)
+	{
+		fd = pairs[i / 2][i % 2];
+		if (fd != node->coord && fd != node->client.fd
+			&& fd != node->server.fd)
+			close(fd);
+		i++;
+	}
+	free(pairs);
+	node_segment(data, k);
+	status = start_simulation(data);
+	cleanup(data);
+	exit(status);
+}
+
+/**
+ * @brief Fork the node processes and coordinate them.
+ *
+ * The coordinator fixes the common start time before forking, so that
+ * every node stamps its log lines against the same origin, then keeps
+ * only its own end of each coordinator socket. If a node cannot be
+ * forked, the nodes already running are stopped.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 on failure.
+ */
+int	nodes_start(t_data *data)
+{
+	int	(*pairs)[2];
+	int	k;
+
+	pairs = open_pairs(data);
+	if (!pairs)
+		return (handle_error(ERR_NODES));
+	fflush(stdout);
+	data->start_time = get_time_us();
+	k = 0;
+	while (k < data->node.count)
+	{
+		data->node.pids[k] = fork();
+		if (data->node.pids[k] == 0)
+			run_node(data, pairs, k);
+		k++;
+	}
+	k = 0;
+	while (k < data->node.count * 4)
+	{
+		if (k / 2 >= data->node.count || k % 2)
+			close(pairs[k / 2][k % 2]);
+		k++;
+	}
+	free(pairs);
+	return (nodes_coordinate(data));
+}
@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   node_coord.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:31:02 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:31:02 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+/**
+ * @brief Stop the distributed simulation: tell every node to stop.
+ *
+ * The log is closed from this point on, so nothing is printed after a
+ * death even though the nodes only learn about it when this message
+ * reaches them.
+ *
+ * @param data Pointer to the coordinator's data structure.
+ */
+static void	node_broadcast(t_data *data)
+{
+	t_msg	msg;
+	int		k;
+
+	if (simulation_over(data))
+		return ;
+	simulation_stop(data);
+	memset(&msg, 0, sizeof(t_msg));
+	msg.type = MSG_STOP;
+	k = 0;
+	while (k < data->node.count)
+	{
+		if (data->node.polls[k].fd >= 0)
+			node_send(data->node.polls[k].fd, &msg);
+		k++;
+	}
+}
+
+/**
+ * @brief Handle one message from a node.
+ *
+ * Status lines are printed in arrival order until the simulation
+ * stops. The first death is printed and stops every node; the time it
+ * took the message to arrive is the detection latency. Once every
+ * node reported that its segment ate enough, the nodes are stopped.
+ *
+ * @param data Pointer to the coordinator's data structure.
+ * @param msg The message received.
+ */
+static void	node_dispatch(t_data *data, t_msg *msg)
+{
+	if (msg->type == MSG_STATUS && !simulation_over(data))
+		printf("%ld %d %s\n", msg->time, msg->id,
+			node_status_text(msg->code));
+	else if (msg->type == MSG_DIED && !simulation_over(data))
+	{
+		printf("%ld %d died\n", msg->time, msg->id);
+		data->node.detect_us = get_time_us() - msg->stamp;
+		data->someone_died = true;
+		node_broadcast(data);
+	}
+	else if (msg->type == MSG_DONE)
+	{
+		data->node.done++;
+		if (data->node.done == data->node.count)
+			node_broadcast(data);
+	}
+	else if (msg->type == MSG_STATS)
+		data->meals_total += msg->time;
+}
+
+/**
+ * @brief Read a ready coordinator socket.
+ *
+ * A node closes its socket right before it exits, and is reaped then.
+ * If the simulation was still running, the node crashed or failed to
+ * start, and the other nodes are stopped.
+ *
+ * @param data Pointer to the coordinator's data structure.
+ * @param k Index of the node.
+ * @return 1 if the node is gone, 0 otherwise.
+ */
+static int	node_receive(t_data *data, int k)
+{
+	t_msg	msg;
+
+	if (recv(data->node.polls[k].fd, &msg, sizeof(t_msg), 0)
+		== sizeof(t_msg))
+	{
+		node_dispatch(data, &msg);
+		return (0);
+	}
+	close(data->node.polls[k].fd);
+	data->node.polls[k].fd = -1;
+	if (data->node.pids[k] > 0)
+		waitpid(data->node.pids[k], NULL, 0);
+	node_broadcast(data);
+	return (1);
+}
+
+/**
+ * @brief Coordinator loop: relay the log and detect the end.
+ *
+ * Runs until every node has exited. The time from the stop broadcast
+ * until the last node is gone is reported by --stats as the teardown
+ * time.
+ *
+ * @param data Pointer to the coordinator's data structure.
+ * @return Always 0.
+ */
+int	nodes_coordinate(t_data *data)
+{
+	int	open;
+	int	k;
+
+	open = data->node.count;
+	while (open > 0)
+	{
+		if (poll(data->node.polls, data->node.count, -1) <= 0)
+			continue ;
+		k = 0;
+		while (k < data->node.count)
+		{
+			if (data->node.polls[k].fd >= 0 && data->node.polls[k].revents)
+				open -= node_receive(data, k);
+			k++;
+		}
+	}
+	data->joined_time = get_time_us();
+	stats_report(data);
+	return (0);
+}
@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   node_link.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:55:12 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:05:05 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <sys/socket.h>
+
+/**
+ * @brief Borrow the boundary fork from the next node.
+ *
+ * Sends a request and sleeps on the link's generation counter until
+ * the client thread receives the grant. simulation_stop bumps the
+ * counter too, so a philosopher waiting for a remote fork still sees
+ * the end of the simulation at once.
+ *
+ * @param data Pointer to the node's data structure.
+ * @return true once the fork is granted, false if the simulation stopped.
+ */
+static bool	link_acquire(t_data *data)
+{
+	t_link	*link;
+	t_msg	msg;
+	int		gen;
+
+	link = &data->node.client;
+	memset(&msg, 0, sizeof(t_msg));
+	msg.type = MSG_REQ;
+	if (node_send(link->fd, &msg))
+		return (false);
+	while (1)
+	{
+		gen = atomic_load(&link->gen);
+		if (atomic_exchange(&link->granted, 0))
+			return (true);
+		if (simulation_over(data))
+			return (false);
+		futex_wait(&link->gen, gen, -1);
+	}
+}
+
+/**
+ * @brief Client side of a link: receive the grants of the next node.
+ *
+ * @param arg Pointer to the node's data structure cast as void*.
+ * @return Always returns NULL, once the next node closed the link.
+ */
+void	*link_client_routine(void *arg)
+{
+	t_link	*link;
+	t_msg	msg;
+
+	link = &((t_data *)arg)->node.client;
+	while (recv(link->fd, &msg, sizeof(t_msg), 0) == sizeof(t_msg))
+	{
+		if (msg.type != MSG_GRANT)
+			continue ;
+		atomic_store(&link->granted, 1);
+		atomic_fetch_add(&link->gen, 1);
+		futex_wake(&link->gen, INT_MAX_VALUE);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Server side of a link: lend fork first to the previous node.
+ *
+ * The server thread takes the fork on behalf of the remote philosopher
+ * with fork_lock, exactly as a local philosopher would, and releases
+ * it when the remote philosopher is done, so the fork token is never
+ * held by two philosophers at once. When the previous node closes the
+ * link, the fork is released and the link closed in turn.
+ *
+ * @param arg Pointer to the node's data structure cast as void*.
+ * @return Always returns NULL.
+ */
+void	*link_server_routine(void *arg)
+{
+	t_data	*data;
+	t_fork	*fork;
+	t_msg	msg;
+	bool	held;
+
+	data = (t_data *)arg;
+	fork = &data->forks[data->node.first];
+	held = false;
+	while (recv(data->node.server.fd, &msg, sizeof(t_msg), 0)
+		== sizeof(t_msg))
+	{
+		if (msg.type == MSG_REL && held)
+			fork_unlock(fork);
+		held = (held && msg.type != MSG_REL);
+		if (msg.type == MSG_REQ && !held && fork_lock(data, fork, FORK_REMOTE))
+		{
+			held = true;
+			msg.type = MSG_GRANT;
+			node_send(data->node.server.fd, &msg);
+		}
+	}
+	if (held)
+		fork_unlock(fork);
+	shutdown(data->node.server.fd, SHUT_WR);
+	return (NULL);
+}
+
+/**
+ * @brief Take the forks of a segment's last philosopher.
+ *
+ * Its left fork is local and its right fork belongs to the next node.
+ * They are taken in the same id-parity order as in a single process,
+ * so the ring as a whole stays deadlock-free.
+ *
+ * @param philo Pointer to the boundary philosopher.
+ * @return true if both forks were taken, false if the simulation stopped.
+ */
+bool	node_take_forks(t_philo *philo)
+{
+	bool	remote_first;
+
+	remote_first = (philo->id % 2 == 0);
+	if (remote_first && !link_acquire(philo->data))
+		return (false);
+	if (remote_first)
+		print_status(philo, "has taken a fork");
+	if (!fork_lock(philo->data, philo->left_fork, philo->id - 1))
+	{
+		if (remote_first)
+			node_release_forks(philo);
+		return (false);
+	}
+	print_status(philo, "has taken a fork");
+	if (!remote_first && !link_acquire(philo->data))
+	{
+		fork_unlock(philo->left_fork);
+		return (false);
+	}
+	if (!remote_first)
+		print_status(philo, "has taken a fork");
+	return (true);
+}
+
+/**
+ * @brief Give the boundary fork back to the next node.
+ *
+ * @param philo Pointer to the boundary philosopher.
+ */
+void	node_release_forks(t_philo *philo)
+{
+	t_msg	msg;
+
+	memset(&msg, 0, sizeof(t_msg));
+	msg.type = MSG_REL;
+	node_send(philo->data->node.client.fd, &msg);
+}
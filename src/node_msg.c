@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   node_msg.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:38:19 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:38:19 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <sys/socket.h>
+
+/**
+ * @brief Status messages a node may report, indexed by their code.
+ *
+ * @return The NULL-terminated table of status texts.
+ */
+static char	**status_table(void)
+{
+	static char	*texts[] = {"has taken a fork", "is eating",
+		"is sleeping", "is thinking", "died", NULL};
+
+	return (texts);
+}
+
+/**
+ * @brief Send one message on a node or coordinator socket.
+ *
+ * MSG_NOSIGNAL keeps a peer that already exited from killing the
+ * sender with SIGPIPE; the failed send is simply reported.
+ *
+ * @param fd The socket to send on.
+ * @param msg The message to send.
+ * @return 0 on success, 1 on failure.
+ */
+int	node_send(int fd, t_msg *msg)
+{
+	return (send(fd, msg, sizeof(t_msg), MSG_NOSIGNAL) != sizeof(t_msg));
+}
+
+/**
+ * @brief Get the text of a status code received from a node.
+ *
+ * @param code The status code.
+ * @return The status text, or "?" for an unknown code.
+ */
+char	*node_status_text(int code)
+{
+	int	i;
+
+	i = 0;
+	while (status_table()[i] && i < code)
+		i++;
+	if (code < 0 || !status_table()[i])
+		return ("?");
+	return (status_table()[i]);
+}
+
+/**
+ * @brief Send a log line to the coordinator instead of printing it.
+ *
+ * Only the coordinator writes to stdout, so that the lines of all the
+ * nodes form one log. Must be called with the print mutex held. A
+ * death is sent as MSG_DIED, stamped with the time of the send so the
+ * coordinator can measure how long detection took to reach it.
+ *
+ * @param data Pointer to the node's data structure.
+ * @param id Id of the philosopher.
+ * @param status The status text, as passed to print_status.
+ * @param time Timestamp of the event in ms since the start.
+ */
+void	node_print(t_data *data, int id, char *status, long time)
+{
+	t_msg	msg;
+
+	memset(&msg, 0, sizeof(t_msg));
+	msg.type = MSG_STATUS;
+	while (status_table()[msg.code]
+		&& strcmp(status_table()[msg.code], status) != 0)
+		msg.code++;
+	if (strcmp(status, "died") == 0)
+		msg.type = MSG_DIED;
+	msg.id = id;
+	msg.time = time;
+	msg.stamp = get_time_us();
+	node_send(data->node.coord, &msg);
+}
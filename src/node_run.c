@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   node_run.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:46:55 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:46:55 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <sys/socket.h>
+
+/**
+ * @brief Node thread listening to the coordinator.
+ *
+ * Stops the node's simulation when the coordinator says so, or when
+ * the coordinator socket is shut down or closed.
+ *
+ * @param arg Pointer to the node's data structure cast as void*.
+ * @return Always returns NULL.
+ */
+static void	*node_reader(void *arg)
+{
+	t_data	*data;
+	t_msg	msg;
+
+	data = (t_data *)arg;
+	while (recv(data->node.coord, &msg, sizeof(t_msg), 0) == sizeof(t_msg))
+	{
+		if (msg.type == MSG_STOP)
+			break ;
+	}
+	pthread_mutex_lock(&data->death_mutex);
+	data->someone_died = true;
+	pthread_mutex_unlock(&data->death_mutex);
+	if (!simulation_over(data))
+		simulation_stop(data);
+	return (NULL);
+}
+
+/**
+ * @brief Restrict a node process to its segment of the ring.
+ *
+ * Node k runs philosophers k * N / K up to (k + 1) * N / K - 1. The
+ * others are marked inactive, so neither the thread start nor the
+ * monitor touches them. The last philosopher of the segment borrows
+ * its right fork from the next node.
+ *
+ * @param data Pointer to the node's data structure.
+ * @param index Index of the node.
+ */
+void	node_segment(t_data *data, int index)
+{
+	t_node	*node;
+	int		i;
+
+	node = &data->node;
+	node->index = index;
+	node->first = (long)index * data->num_philos / node->count;
+	node->last = (long)(index + 1) * data->num_philos / node->count - 1;
+	i = 0;
+	while (i < data->num_philos)
+	{
+		atomic_store(&data->philos[i].active,
+			i >= node->first && i <= node->last);
+		i++;
+	}
+	data->philos[node->last].remote = true;
+}
+
+/**
+ * @brief Start the node's coordinator and link threads.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success (or outside a node process), 1 on failure.
+ */
+int	node_start(t_data *data)
+{
+	t_node	*node;
+
+	node = &data->node;
+	if (node->index < 0)
+		return (0);
+	if (pthread_create(&node->reader, NULL, node_reader, data))
+		return (handle_error(ERR_NODES));
+	node->reading = true;
+	if (pthread_create(&node->client.thread, NULL, link_client_routine,
+			data))
+		return (handle_error(ERR_NODES));
+	node->client.running = true;
+	if (pthread_create(&node->server.thread, NULL, link_server_routine,
+			data))
+		return (handle_error(ERR_NODES));
+	node->server.running = true;
+	return (0);
+}
+
+/**
+ * @brief Shut a node down once its philosophers are joined.
+ *
+ * Closing the write side of the client link lets the next node's
+ * server thread finish, which in turn closes our client thread's
+ * input; no node waits for another one to stop first. The meal count
+ * is sent to the coordinator before the node exits.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	node_join(t_data *data)
+{
+	t_node	*node;
+	t_msg	msg;
+
+	node = &data->node;
+	if (node->index < 0)
+		return ;
+	shutdown(node->client.fd, SHUT_WR);
+	shutdown(node->coord, SHUT_RD);
+	if (node->reading)
+		pthread_join(node->reader, NULL);
+	if (node->client.running)
+		pthread_join(node->client.thread, NULL);
+	if (node->server.running)
+		pthread_join(node->server.thread, NULL);
+	memset(&msg, 0, sizeof(t_msg));
+	msg.type = MSG_STATS;
+	msg.time = data->meals_total;
+	node_send(node->coord, &msg);
+	close(node->client.fd);
+	close(node->server.fd);
+	close(node->coord);
+}
+
+/**
+ * @brief Tell the coordinator, once, that this segment ate enough.
+ *
+ * The node keeps running: its philosophers go on eating until every
+ * segment is done, as in a single process.
+ *
+ * @param data Pointer to the node's data structure.
+ * @return Always false: the node's monitor keeps going.
+ */
+bool	node_done(t_data *data)
+{
+	t_msg	msg;
+
+	if (data->node.done_sent)
+		return (false);
+	data->node.done_sent = true;
+	memset(&msg, 0, sizeof(t_msg));
+	msg.type = MSG_DONE;
+	node_send(data->node.coord, &msg);
+	return (false);
+}
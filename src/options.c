@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:02:11 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:34:02 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Match an option name and return a pointer to its value.
+ *
+ * Compares the argument against "--name" and accepts either an exact
+ * match (flag without value) or "--name=value".
+ *
+ * @param arg The command-line argument to inspect.
+ * @param name The option name without the leading dashes.
+ * @return Pointer to the value, to an empty string for a bare flag,
+ *         or NULL if the argument is a different option.
+ */
+char	*option_value(char *arg, const char *name)
+{
+	int	i;
+
+	i = 0;
+	while (name[i] && arg[i + 2] == name[i])
+		i++;
+	if (name[i])
+		return (NULL);
+	if (arg[i + 2] == '=')
+		return (arg + i + 3);
+	if (arg[i + 2] == '\0')
+		return (arg + i + 2);
+	return (NULL);
+}
+
+/**
+ * @brief Store a single "--name=value" option in the options structure.
+ *
+ * @param opts Pointer to the options structure being filled.
+ * @param arg The command-line argument, starting with "--".
+ * @return 0 if the option is known and well-formed, 1 otherwise.
+ */
+static int	store_option(t_opts *opts, char *arg)
+{
+	if (store_named(opts, arg) == 0)
+		return (0);
+	if (option_value(arg, "forks")
+		&& (!strcmp(option_value(arg, "forks"), "bitmap")
+			|| !strcmp(option_value(arg, "forks"), "mutex")))
+		opts->bitmap = !strcmp(option_value(arg, "forks"), "bitmap");
+	else if (option_value(arg, "plan") && !*option_value(arg, "plan"))
+		opts->plan = PLAN_TRIALS;
+	else if (option_value(arg, "rt") && (!*option_value(arg, "rt")
+			|| !strcmp(option_value(arg, "rt"), "fifo")))
+		opts->rt_policy = SCHED_FIFO;
+	else if (option_value(arg, "rt") && !strcmp(option_value(arg, "rt"), "rr"))
+		opts->rt_policy = SCHED_RR;
+	else
+		return (1);
+	return (0);
+}
+
+/**
+ * @brief Extract "--name=value" options from the argument vector.
+ *
+ * Every argument starting with "--" is consumed as an option and
+ * removed from argv, so the remaining positional arguments keep the
+ * classic layout expected by validate_args and init_data. Options may
+ * appear anywhere on the command line.
+ *
+ * @param opts Pointer to the options structure to fill.
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings, compacted in place.
+ * @return The new argument count, or -1 on an unknown option.
+ */
+int	parse_options(t_opts *opts, int argc, char **argv)
+{
+	int	i;
+	int	kept;
+
+	memset(opts, 0, sizeof(t_opts));
+	i = 1;
+	kept = 1;
+	while (i < argc)
+	{
+		if (argv[i][0] == '-' && argv[i][1] == '-')
+		{
+			if (store_option(opts, argv[i]))
+			{
+				handle_error(ERR_OPTION);
+				return (-1);
+			}
+		}
+		else
+		{
+			argv[kept] = argv[i];
+			kept++;
+		}
+		i++;
+	}
+	argv[kept] = NULL;
+	return (kept);
+}
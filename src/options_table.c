@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_table.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:57 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:57 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Store a "--name=path" option in the options structure.
+ *
+ * @param opts Pointer to the options structure being filled.
+ * @param arg The command-line argument, starting with "--".
+ * @return 0 if the argument is a path option with a value, 1 otherwise.
+ */
+static int	store_path(t_opts *opts, char *arg)
+{
+	if (option_value(arg, "record") && *option_value(arg, "record"))
+		opts->record_path = option_value(arg, "record");
+	else if (option_value(arg, "replay") && *option_value(arg, "replay"))
+		opts->replay_path = option_value(arg, "replay");
+	else if (option_value(arg, "topology") && *option_value(arg, "topology"))
+		opts->topology_path = option_value(arg, "topology");
+	else if (option_value(arg, "control") && *option_value(arg, "control"))
+		opts->control_path = option_value(arg, "control");
+	else
+		return (1);
+	return (0);
+}
+
+/**
+ * @brief Store a "--name=N" option in the options structure.
+ *
+ * Every numeric option takes a strictly positive value.
+ *
+ * @param opts Pointer to the options structure being filled.
+ * @param arg The command-line argument, starting with "--".
+ * @return 0 if the argument is a numeric option with a valid value,
+ *         1 otherwise.
+ */
+static int	store_number(t_opts *opts, char *arg)
+{
+	static const char	*names[] = {"capacity", "nodes", "plan", "jobs",
+		"rt-monitor", "rt-philo"};
+	long				*fields[6];
+	char				*value;
+	int					i;
+
+	fields[0] = &opts->capacity;
+	fields[1] = &opts->nodes;
+	fields[2] = &opts->plan;
+	fields[3] = &opts->jobs;
+	fields[4] = &opts->rt_monitor;
+	fields[5] = &opts->rt_philo;
+	i = 0;
+	while (i < 6)
+	{
+		value = option_value(arg, names[i]);
+		if (value && is_valid_number(value) && ft_atol(value) > 0)
+		{
+			*fields[i] = ft_atol(value);
+			return (0);
+		}
+		i++;
+	}
+	return (1);
+}
+
+/**
+ * @brief Store a bare "--name" flag in the options structure.
+ *
+ * @param opts Pointer to the options structure being filled.
+ * @param arg The command-line argument, starting with "--".
+ * @return 0 if the argument is a flag without a value, 1 otherwise.
+ */
+static int	store_flag(t_opts *opts, char *arg)
+{
+	static const char	*names[] = {"detect", "mlock", "perf", "stats",
+		"timetable"};
+	bool				*fields[5];
+	char				*value;
+	int					i;
+
+	fields[0] = &opts->detect;
+	fields[1] = &opts->mlock;
+	fields[2] = &opts->perf;
+	fields[3] = &opts->stats;
+	fields[4] = &opts->timetable;
+	i = 0;
+	while (i < 5)
+	{
+		value = option_value(arg, names[i]);
+		if (value && !*value)
+		{
+			*fields[i] = true;
+			return (0);
+		}
+		i++;
+	}
+	return (1);
+}
+
+/**
+ * @brief Store an option listed in one of the tables above.
+ *
+ * @param opts Pointer to the options structure being filled.
+ * @param arg The command-line argument, starting with "--".
+ * @return 0 if the argument is a known path, number or flag option
+ *         with a well-formed value, 1 otherwise.
+ */
+int	store_named(t_opts *opts, char *arg)
+{
+	if (store_path(opts, arg) == 0 || store_number(opts, arg) == 0
+		|| store_flag(opts, arg) == 0)
+		return (0);
+	return (1);
+}
@@ -6,7 +6,7 @@
 /*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/12 19:07:08 by mona              #+#    #+#             */
-/*   Updated: 2026/01/12 19:17:12 by mona             ###   ########.fr       */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -108,3 +108,37 @@ int	ft_atoi(const char *str)
 {
 	return ((int)ft_atol(str));
 }
+
+/**
+ * @brief Get the unit of a duration argument.
+ *
+ * The timing arguments take an optional unit suffix after the digits:
+ * "us", "ms" or "s". A bare number is in milliseconds, as it always
+ * was, so "200" and "200ms" mean the same and "250us" gives a
+ * sub-millisecond phase.
+ *
+ * @param str The argument, a number as accepted by is_valid_number
+ *            followed by an optional suffix.
+ * @return Microseconds per unit, or 0 if the argument is malformed.
+ */
+long	duration_scale(const char *str)
+{
+	int	i;
+
+	i = 0;
+	while (ft_isspace(str[i]))
+		i++;
+	if (str[i] == '+')
+		i++;
+	if (str[i] < '0' || str[i] > '9')
+		return (0);
+	while (str[i] >= '0' && str[i] <= '9')
+		i++;
+	if (!strcmp(str + i, "") || !strcmp(str + i, "ms"))
+		return (1000);
+	if (!strcmp(str + i, "us"))
+		return (1);
+	if (!strcmp(str + i, "s"))
+		return (1000000);
+	return (0);
+}
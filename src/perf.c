@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:58:40 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:58:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <fcntl.h>
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/syscall.h>
+#endif
+
+/**
+ * @brief Find the id of the raw_syscalls:sys_enter tracepoint.
+ *
+ * @return The tracepoint id, or -1 if tracefs is not mounted.
+ */
+static long	syscall_tracepoint(void)
+{
+	char	buf[32];
+	ssize_t	len;
+	int		fd;
+
+	fd = open("/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+			O_RDONLY);
+	if (fd < 0)
+		fd = open("/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/"
+				"id", O_RDONLY);
+	if (fd < 0)
+		return (-1);
+	len = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (len <= 0)
+		return (-1);
+	buf[len] = '\0';
+	return (ft_atol(buf));
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Open one counter on the calling thread.
+ *
+ * Counters: context switches, syscalls (the sys_enter tracepoint),
+ * cycles, instructions, cache misses and task clock (nanoseconds).
+ *
+ * @param data Pointer to the shared data structure.
+ * @param counter Index of the counter.
+ * @param user_only Count user space only, which an unprivileged
+ *                  process may still be allowed to do.
+ * @return The counter fd, or -1 if the kernel refused it.
+ */
+int	perf_open(t_data *data, int counter, bool user_only)
+{
+	static const int		types[] = {PERF_TYPE_SOFTWARE,
+		PERF_TYPE_TRACEPOINT, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+		PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE};
+	static const long		configs[] = {PERF_COUNT_SW_CONTEXT_SWITCHES, 0,
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_SW_TASK_CLOCK};
+	struct perf_event_attr	attr;
+
+	if (counter == 1 && data->perf_tracepoint < 0)
+		return (-1);
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = types[counter];
+	attr.config = configs[counter];
+	if (counter == 1)
+		attr.config = data->perf_tracepoint;
+	attr.exclude_kernel = user_only;
+	attr.exclude_hv = user_only;
+	return (syscall(SYS_perf_event_open, &attr, 0, -1, -1,
+			PERF_FLAG_FD_CLOEXEC));
+}
+
+#else
+
+/**
+ * @brief Portable fallback: perf_event_open does not exist.
+ */
+int	perf_open(t_data *data, int counter, bool user_only)
+{
+	(void)data;
+	(void)counter;
+	(void)user_only;
+	return (-1);
+}
+
+#endif
+
+/**
+ * @brief Pick how one counter will be measured.
+ *
+ * A probe counter is opened and closed on the main thread. Hardware
+ * counters fall back to user space only when the kernel refuses
+ * kernel counting; context switches and CPU time fall back to
+ * getrusage; syscalls have no fallback.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param counter Index of the counter.
+ * @return PERF_EVENT, PERF_USER, PERF_RUSAGE or PERF_NONE.
+ */
+static int	counter_mode(t_data *data, int counter)
+{
+	int	fd;
+	int	mode;
+
+	mode = PERF_EVENT;
+	fd = perf_open(data, counter, false);
+	if (fd < 0 && counter >= 2 && counter <= 4)
+	{
+		mode = PERF_USER;
+		fd = perf_open(data, counter, true);
+	}
+	if (fd >= 0)
+	{
+		close(fd);
+		return (mode);
+	}
+	if (counter == 0 || counter == PERF_COUNTERS - 1)
+		return (PERF_RUSAGE);
+	return (PERF_NONE);
+}
+
+/**
+ * @brief Set up --perf before any thread starts.
+ *
+ * Clears the totals and decides, per counter, whether the threads will
+ * use perf_event_open or getrusage. Node processes cannot add their
+ * counts to the coordinator's, so --perf and --nodes are exclusive.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 with --nodes.
+ */
+int	perf_configure(t_data *data)
+{
+	int	i;
+
+	i = 0;
+	while (i < PERF_COUNTERS)
+	{
+		atomic_init(&data->perf_total[PERF_PHILOS][i], 0);
+		atomic_init(&data->perf_total[PERF_MONITOR][i], 0);
+		data->perf_mode[i] = PERF_NONE;
+		i++;
+	}
+	if (!data->opts.perf)
+		return (0);
+	if (data->opts.nodes)
+		return (handle_error(ERR_PERF));
+	data->perf_tracepoint = syscall_tracepoint();
+	i = 0;
+	while (i < PERF_COUNTERS)
+	{
+		data->perf_mode[i] = counter_mode(data, i);
+		i++;
+	}
+	return (0);
+}
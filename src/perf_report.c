@@ -0,0 +1,79 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf_report.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:40 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Print one counter of one thread class.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param counter Index of the counter.
+ * @param class PERF_PHILOS or PERF_MONITOR.
+ * @param seconds Simulated time, in seconds.
+ */
+static void	report_counter(t_data *data, int counter, int class,
+	double seconds)
+{
+	static const char	*names[] = {"context_switches", "syscalls",
+		"cycles", "instructions", "cache_misses", "cpu_us"};
+	static const char	*sources[] = {"n/a", "perf_event",
+		"perf_event_user", "getrusage"};
+	static const char	*classes[] = {"philos", "monitor"};
+	long long			total;
+	long				meals;
+
+	if (data->perf_mode[counter] == PERF_NONE)
+	{
+		fprintf(stderr, "%-16s %-7s %14s %12s %14s %s\n", names[counter],
+			classes[class], "-", "-", "-", sources[PERF_NONE]);
+		return ;
+	}
+	total = atomic_load(&data->perf_total[class][counter]);
+	meals = data->meals_total;
+	if (meals < 1)
+		meals = 1;
+	fprintf(stderr, "%-16s %-7s %14lld %12.2f %14.1f %s\n", names[counter],
+		classes[class], total, (double)total / meals, total / seconds,
+		sources[data->perf_mode[counter]]);
+}
+
+/**
+ * @brief Print the --perf cost model to stderr.
+ *
+ * Every counter is split between the philosopher threads and the
+ * monitor, and given as a total, per meal eaten and per simulated
+ * second. The source column tells how it was measured: perf_event,
+ * perf_event_user (user space only, when the kernel keeps its own
+ * side private), getrusage, or n/a.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	perf_report(t_data *data)
+{
+	double	seconds;
+	int		i;
+
+	if (!data->opts.perf)
+		return ;
+	seconds = (data->stop_time - data->start_time) / 1e6;
+	if (seconds <= 0)
+		seconds = 1e-6;
+	fprintf(stderr, "%-16s %-7s %14s %12s %14s %s\n", "counter", "threads",
+		"total", "per_meal", "per_sim_sec", "source");
+	i = 0;
+	while (i < PERF_COUNTERS)
+	{
+		report_counter(data, i, PERF_PHILOS, seconds);
+		report_counter(data, i, PERF_MONITOR, seconds);
+		i++;
+	}
+}
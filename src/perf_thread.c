@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   perf_thread.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:02 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:02 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Read a getrusage-backed counter since the thread started.
+ *
+ * @param perf Pointer to the thread's counters.
+ * @param counter 0 for context switches, anything else for CPU time.
+ * @return Context switches, or CPU time in microseconds.
+ */
+static long long	usage_value(t_perf *perf, int counter)
+{
+	struct rusage	now;
+	long long		cpu;
+
+	getrusage(RUSAGE_THREAD, &now);
+	if (counter == 0)
+		return ((now.ru_nvcsw + now.ru_nivcsw)
+			- (perf->usage.ru_nvcsw + perf->usage.ru_nivcsw));
+	cpu = (now.ru_utime.tv_sec + now.ru_stime.tv_sec
+			- perf->usage.ru_utime.tv_sec - perf->usage.ru_stime.tv_sec)
+		* 1000000LL;
+	return (cpu + now.ru_utime.tv_usec + now.ru_stime.tv_usec
+		- perf->usage.ru_utime.tv_usec - perf->usage.ru_stime.tv_usec);
+}
+
+/**
+ * @brief Start counting for the calling thread.
+ *
+ * Called first thing by every philosopher and monitor thread with
+ * --perf: perf_event counters count the thread that opens them.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param perf Pointer to the thread's counters, on its own stack.
+ */
+void	perf_begin(t_data *data, t_perf *perf)
+{
+	int	i;
+
+	if (!data->opts.perf)
+		return ;
+	i = 0;
+	while (i < PERF_COUNTERS)
+	{
+		perf->fd[i] = -1;
+		if (data->perf_mode[i] == PERF_EVENT
+			|| data->perf_mode[i] == PERF_USER)
+			perf->fd[i] = perf_open(data, i, data->perf_mode[i] == PERF_USER);
+		i++;
+	}
+	getrusage(RUSAGE_THREAD, &perf->usage);
+}
+
+/**
+ * @brief Stop counting and add the thread's counts to its class.
+ *
+ * A counter that could not be opened on this thread is left out.
+ * The task clock is converted from nanoseconds to microseconds.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param perf Pointer to the thread's counters.
+ * @param class PERF_PHILOS or PERF_MONITOR.
+ */
+void	perf_end(t_data *data, t_perf *perf, int class)
+{
+	long long	value;
+	int			i;
+
+	i = 0;
+	while (data->opts.perf && i < PERF_COUNTERS)
+	{
+		value = 0;
+		if (perf->fd[i] >= 0)
+		{
+			if (read(perf->fd[i], &value, sizeof(value)) != sizeof(value))
+				value = 0;
+			close(perf->fd[i]);
+			if (i == PERF_COUNTERS - 1)
+				value /= 1000;
+		}
+		else if (data->perf_mode[i] == PERF_RUSAGE)
+			value = usage_value(perf, i);
+		atomic_fetch_add(&data->perf_total[class][i], value);
+		i++;
+	}
+}
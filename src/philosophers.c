@@ -6,7 +6,7 @@
 /*   By: maria-ol <maria-ol@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/07 13:45:24 by mona              #+#    #+#             */
-/*   Updated: 2026/01/13 18:08:29 by maria-ol         ###   ########.fr       */
+/*   Updated: 2026/10/18 23:38:40 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,7 +19,8 @@
  * (between 5 and 6) and ensures all numeric arguments are positive
  * integers. The expected format is: ./philo number_of_philosophers
  * time_to_die time_to_eat time_to_sleep [number_of_times_each_
- * philosopher_must_eat].
+ * philosopher_must_eat]. The three times may carry a unit suffix
+ * (see duration_scale); the range checks apply to the number itself.
  *
  * @param argc Number of command-line arguments.
  * @param argv Array of command-line argument strings.
@@ -35,7 +36,8 @@ static int	validate_args(int argc, char **argv)
 	i = 1;
 	while (i < argc)
 	{
-		if (!is_valid_number(argv[i]))
+		if (!is_valid_number(argv[i])
+			&& (i < 2 || i > 4 || !duration_scale(argv[i])))
 			return (handle_error(ERR_INVALID_FORMAT));
 		value = ft_atol(argv[i]);
 		if (value > INT_MAX_VALUE)
@@ -47,85 +49,14 @@ static int	validate_args(int argc, char **argv)
 	return (0);
 }
 
-/**
- * @brief Initialize synchronized meal timestamps for all philosophers.
- *
- * This function performs a critical synchronized initialization by
- * setting the simulation start time and initializing all philosophers'
- * last_meal_time to this exact timestamp. This ensures all philosophers
- * begin with the same time reference, preventing race conditions where
- * the monitor could detect false deaths if timestamps were initialized
- * individually by each thread. The meal_mutex protects this atomic
- * operation, guaranteeing all timestamps are set before any philosopher
- * thread starts checking for starvation.
- *
- * @param data Pointer to the shared data structure containing all
- *             simulation parameters and philosopher information.
- * @return 0 on success.
- */
-static int	meal_simulation(t_data *data)
-{
-	int			i;
-
-	data->start_time = get_time();
-	pthread_mutex_lock(&data->meal_mutex);
-	i = 0;
-	while (i < data->num_philos)
-	{
-		data->philos[i].last_meal_time = data->start_time;
-		i++;
-	}
-	pthread_mutex_unlock(&data->meal_mutex);
-	return (0);
-}
-
-/**
- * @brief Start the philosophers simulation.
- *
- * This function initializes the simulation start time, creates a
- * thread for each philosopher, and creates a monitor thread to check
- * for death or completion conditions. It then waits for all threads
- * to finish before returning. Each philosopher's last_meal_time is
- * initialized to the simulation start time.
- *
- * @param data Pointer to the shared data structure containing all
- *             simulation parameters and philosopher information.
- * @return 0 on success, 1 on failure.
- */
-static int	start_simulation(t_data *data)
-{
-	int			i;
-	pthread_t	monitor;
-
-	meal_simulation(data);
-	i = 0;
-	while (i < data->num_philos)
-	{
-		if (pthread_create(&data->philos[i].thread, NULL,
-				philo_routine, &data->philos[i]))
-			return (handle_error(ERR_PHILO_THREAD));
-		i++;
-	}
-	if (pthread_create(&monitor, NULL, monitor_routine, data))
-		return (handle_error(ERR_MONIT_THREAD));
-	i = 0;
-	while (i < data->num_philos)
-	{
-		pthread_join(data->philos[i].thread, NULL);
-		i++;
-	}
-	pthread_join(monitor, NULL);
-	return (0);
-}
-
 /**
  * @brief Main coordinator function for the philosophers simulation.
  *
  * This function implements the main flow of the philosophers
- * simulation. It validates arguments, initializes the shared data
- * structure, mutexes, and philosophers, then starts the simulation.
- * All resources are properly cleaned up before returning, regardless
- * of success or failure.
+ * simulation. It extracts "--" options, validates arguments and
+ * initializes the shared data structure, then either runs the
+ * simulation or, with --plan, searches for the smallest survivable
+ * time_to_die.
  *
  * @param argc Number of command-line arguments.
  * @param argv Array of command-line argument strings.
@@ -135,25 +66,12 @@ int	main(int argc, char **argv)
 {
 	t_data	data;
 
-	if (validate_args(argc, argv))
+	argc = parse_options(&data.opts, argc, argv);
+	if (argc < 0 || validate_args(argc, argv))
 		return (1);
 	if (init_data(&data, argc, argv))
 		return (1);
-	if (init_mutexes(&data))
-	{
-		cleanup(&data);
-		return (1);
-	}
-	if (init_philos(&data))
-	{
-		cleanup(&data);
-		return (1);
-	}
-	if (start_simulation(&data))
-	{
-		cleanup(&data);
-		return (1);
-	}
-	cleanup(&data);
-	return (0);
+	if (data.opts.plan)
+		return (plan_run(&data));
+	return (run_simulation(&data));
 }
@@ -0,0 +1,188 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   plan.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:24:46 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:34:02 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Lower bound on a survivable time_to_die for the ring.
+ *
+ * A philosopher cannot eat again sooner than time_to_eat +
+ * time_to_sleep after its last meal. On top of that, at most N / 2
+ * philosophers eat at the same time, so the N meals of one round need
+ * at least N * time_to_eat / (N / 2): 2 * time_to_eat for an even
+ * N, more for an odd one. Any shorter time_to_die kills someone once
+ * everyone has to eat a second time. The bound is rounded up to the
+ * search step.
+ *
+ * @param data Pointer to the configuration filled by init_data.
+ * @param step Resolution of the search, in microseconds.
+ * @return The theoretical minimum time_to_die, in microseconds.
+ */
+static long	ring_minimum(t_data *data, long step)
+{
+	long	slots;
+	long	round;
+	long	cycle;
+
+	slots = data->num_philos / 2;
+	round = (data->num_philos * data->time_to_eat + slots - 1) / slots;
+	cycle = data->time_to_eat + data->time_to_sleep;
+	if (round > cycle)
+		cycle = round;
+	return ((cycle + step - 1) / step * step);
+}
+
+/**
+ * @brief Check the options and size the planner.
+ *
+ * Trials run the plain ring, optionally with --forks=bitmap; options
+ * that write files, read commands or fork processes of their own are
+ * rejected. Without a meal count, each trial stops after PLAN_MEALS
+ * meals per philosopher. --jobs defaults to the number of online CPUs:
+ * trials sharing a CPU would delay each other and die for it. The
+ * search works in whole milliseconds, unless a time was given finer.
+ *
+ * @param data Pointer to the configuration filled by init_data.
+ * @param plan Pointer to the planner state to fill.
+ * @return 0 on success, 1 on failure.
+ */
+static int	plan_setup(t_data *data, t_plan *plan)
+{
+	if (data->opts.record_path || data->opts.replay_path
+		|| data->opts.topology_path || data->opts.control_path
+		|| data->opts.nodes || data->opts.timetable)
+		return (handle_error(ERR_PLAN));
+	if (data->num_must_eat == -1)
+		data->num_must_eat = PLAN_MEALS;
+	plan->trials = data->opts.plan;
+	plan->jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	if (data->opts.jobs)
+		plan->jobs = data->opts.jobs;
+	if (plan->jobs > plan->trials)
+		plan->jobs = plan->trials;
+	if (plan->jobs < 1)
+		plan->jobs = 1;
+	plan->running = 0;
+	plan->step = 1000;
+	if (data->time_to_die % 1000 || data->time_to_eat % 1000
+		|| data->time_to_sleep % 1000)
+		plan->step = 1;
+	plan->pids = calloc(plan->jobs, sizeof(pid_t));
+	if (!plan->pids)
+		return (handle_error(ERR_ALOC));
+	return (0);
+}
+
+/**
+ * @brief Run one candidate and report its outcome on stderr.
+ *
+ * @param data Pointer to the configuration filled by init_data.
+ * @param plan Pointer to the planner state.
+ * @param time_to_die The candidate time_to_die, in microseconds.
+ * @return Number of trials that survived, or -1 on failure.
+ */
+static long	plan_probe(t_data *data, t_plan *plan, long time_to_die)
+{
+	long	survived;
+
+	survived = plan_candidate(data, plan, time_to_die);
+	if (survived < 0)
+		return (survived);
+	print_ms(stderr, "time_to_die ", time_to_die, ": ");
+	if (survived == plan->trials)
+		fprintf(stderr, "%ld trials survived\n", survived);
+	else
+		fprintf(stderr, "died after %ld survived\n", survived);
+	return (survived);
+}
+
+/**
+ * @brief Binary-search the smallest time_to_die all trials survive.
+ *
+ * lo is known to kill someone and hi must survive. If hi does not, it
+ * is doubled until it does or PLAN_MAX_MS is reached. Candidates stay
+ * multiples of the search step.
+ *
+ * @param data Pointer to the configuration filled by init_data.
+ * @param plan Pointer to the planner state.
+ * @param lo A time_to_die known to be fatal.
+ * @param hi The first candidate expected to survive.
+ * @return The threshold in microseconds, 0 if none was found, -1 on
+ *         failure.
+ */
+static long	plan_search(t_data *data, t_plan *plan, long lo, long hi)
+{
+	long	survived;
+	long	mid;
+
+	survived = plan_probe(data, plan, hi);
+	while (survived >= 0 && survived < plan->trials)
+	{
+		lo = hi;
+		hi *= 2;
+		if (hi > PLAN_MAX_MS * 1000L)
+			return (0);
+		survived = plan_probe(data, plan, hi);
+	}
+	while (survived >= 0 && hi - lo > plan->step)
+	{
+		mid = lo + (hi - lo) / plan->step / 2 * plan->step;
+		survived = plan_probe(data, plan, mid);
+		if (survived == plan->trials)
+			hi = mid;
+		else
+			lo = mid;
+	}
+	if (survived < 0)
+		return (-1);
+	return (hi);
+}
+
+/**
+ * @brief Capacity planner: find the tightest survivable time_to_die.
+ *
+ * The time_to_die given on the command line is the first candidate.
+ * The search runs plan->trials trials per candidate and reports, on
+ * stdout, the threshold next to the theoretical minimum. Having seen
+ * no death in n trials bounds the death rate below 3 / n with 95%
+ * confidence (the rule of three).
+ *
+ * @param data Pointer to the configuration filled by init_data.
+ * @return 0 if a threshold was found, 1 otherwise.
+ */
+int	plan_run(t_data *data)
+{
+	t_plan	plan;
+	long	minimum;
+	long	found;
+	long	lo;
+
+	if (plan_setup(data, &plan))
+		return (1);
+	minimum = ring_minimum(data, plan.step);
+	lo = minimum - plan.step;
+	if (data->num_must_eat < 2)
+		lo = 0;
+	if (data->time_to_die <= lo)
+		data->time_to_die = lo + plan.step;
+	found = plan_search(data, &plan, lo, data->time_to_die);
+	free(plan.pids);
+	if (found < 0)
+		return (handle_error(ERR_PLAN));
+	print_ms(stdout, "theoretical_min_ms ", minimum, "\n");
+	print_ms(stdout, "min_time_to_die_ms ", found, "\n");
+	printf("trials %ld\nmeals %d\n", plan.trials, data->num_must_eat);
+	if (plan.trials >= 3)
+		printf("death_rate_below %.1f%% (95%% confidence)\n",
+			300.0 / plan.trials);
+	return (found == 0);
+}
@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   plan_trial.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:31:08 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:23:34 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+/**
+ * @brief Body of a trial process: run one silent simulation and exit.
+ *
+ * The log goes to /dev/null and --stats is off, so only the exit
+ * status reaches the planner: 0 if everyone survived, PLAN_DIED if
+ * someone died, 1 if the simulation could not run.
+ *
+ * @param data Pointer to the configuration filled by init_data.
+ * @param time_to_die The candidate time_to_die, in microseconds.
+ */
+static void	trial_body(t_data *data, long time_to_die)
+{
+	int	fd;
+	int	status;
+
+	fd = open("/dev/null", O_WRONLY);
+	if (fd >= 0)
+	{
+		dup2(fd, STDOUT_FILENO);
+		close(fd);
+	}
+	data->time_to_die = time_to_die;
+	data->min_slack = time_to_die;
+	data->opts.stats = false;
+	data->opts.perf = false;
+	status = run_simulation(data);
+	if (status == 0 && data->someone_died)
+		status = PLAN_DIED;
+	exit(status);
+}
+
+/**
+ * @brief Fork one trial into a free slot.
+ *
+ * @param data Pointer to the configuration filled by init_data.
+ * @param plan Pointer to the planner state.
+ * @param time_to_die The candidate time_to_die, in microseconds.
+ * @return 0 on success, 1 if the process could not be created.
+ */
+static int	trial_start(t_data *data, t_plan *plan, long time_to_die)
+{
+	int	slot;
+
+	slot = 0;
+	while (plan->pids[slot])
+		slot++;
+	fflush(stdout);
+	plan->pids[slot] = fork();
+	if (plan->pids[slot] < 0)
+	{
+		plan->pids[slot] = 0;
+		return (1);
+	}
+	if (plan->pids[slot] == 0)
+		trial_body(data, time_to_die);
+	plan->running++;
+	return (0);
+}
+
+/**
+ * @brief Wait for the next trial to end and free its slot.
+ *
+ * @param plan Pointer to the planner state.
+ * @return The trial's exit status, or 1 if it did not exit normally.
+ */
+static int	trial_reap(t_plan *plan)
+{
+	pid_t	pid;
+	int		status;
+	int		slot;
+
+	pid = waitpid(-1, &status, 0);
+	if (pid <= 0)
+	{
+		plan->running = 0;
+		return (1);
+	}
+	slot = 0;
+	while (slot < plan->jobs && plan->pids[slot] != pid)
+		slot++;
+	if (slot < plan->jobs)
+		plan->pids[slot] = 0;
+	plan->running--;
+	if (WIFEXITED(status))
+		return (WEXITSTATUS(status));
+	return (1);
+}
+
+/**
+ * @brief Kill and reap every trial still running.
+ *
+ * @param plan Pointer to the planner state.
+ * @param result Value to hand back to the caller.
+ * @return result, so that callers can stop and return in one step.
+ */
+static long	trials_abort(t_plan *plan, long result)
+{
+	int	slot;
+
+	slot = 0;
+	while (slot < plan->jobs)
+	{
+		if (plan->pids[slot])
+			kill(plan->pids[slot], SIGKILL);
+		slot++;
+	}
+	while (plan->running > 0)
+		trial_reap(plan);
+	return (result);
+}
+
+/**
+ * @brief Run the trials of one candidate time_to_die, jobs at a time.
+ *
+ * Up to plan->jobs trials run in parallel. The first death settles
+ * the candidate: the remaining trials are killed at once.
+ *
+ * @param data Pointer to the configuration filled by init_data.
+ * @param plan Pointer to the planner state.
+ * @param time_to_die The candidate time_to_die, in microseconds.
+ * @return Number of trials that survived (plan->trials if all did),
+ *         or -1 if a trial could not run.
+ */
+long	plan_candidate(t_data *data, t_plan *plan, long time_to_die)
+{
+	long	started;
+	long	survived;
+	int		status;
+
+	started = 0;
+	survived = 0;
+	while (survived < plan->trials)
+	{
+		while (started < plan->trials && plan->running < plan->jobs)
+		{
+			if (trial_start(data, plan, time_to_die))
+				return (trials_abort(plan, -1));
+			started++;
+		}
+		status = trial_reap(plan);
+		if (status == PLAN_DIED)
+			return (trials_abort(plan, survived));
+		if (status != 0)
+			return (trials_abort(plan, -1));
+		survived++;
+	}
+	return (survived);
+}
@@ -0,0 +1,40 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   probes.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:41:12 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:41:12 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "probes.h"
+
+#ifdef PHILO_PROBES
+
+/*
+** Probe semaphores, in the section where <sys/sdt.h> tools look for
+** them. A tracer attached to a probe increments its semaphore.
+*/
+unsigned short	philo_fork_taken_semaphore
+	__attribute__((section(".probes")));
+unsigned short	philo_forks_granted_semaphore
+	__attribute__((section(".probes")));
+unsigned short	philo_eat_start_semaphore
+	__attribute__((section(".probes")));
+unsigned short	philo_eat_end_semaphore
+	__attribute__((section(".probes")));
+unsigned short	philo_sleep_semaphore
+	__attribute__((section(".probes")));
+unsigned short	philo_think_semaphore
+	__attribute__((section(".probes")));
+unsigned short	philo_check_semaphore
+	__attribute__((section(".probes")));
+unsigned short	philo_death_semaphore
+	__attribute__((section(".probes")));
+unsigned short	philo_status_semaphore
+	__attribute__((section(".probes")));
+
+#endif
@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   realtime.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:07:37 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:07:37 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include <errno.h>
+
+/**
+ * @brief Check a priority against the range of the chosen policy.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param priority The priority to check; 0 leaves the class alone.
+ * @return true if the priority is 0 or valid for the policy.
+ */
+static bool	rt_valid(t_data *data, long priority)
+{
+	return (priority == 0
+		|| (priority >= sched_get_priority_min(data->opts.rt_policy)
+			&& priority <= sched_get_priority_max(data->opts.rt_policy)));
+}
+
+/**
+ * @brief Resolve the real-time options.
+ *
+ * --rt-monitor and --rt-philo select which threads run under the
+ * real-time policy, SCHED_FIFO unless --rt=rr is given. With --rt
+ * alone, both the monitor (RT_MONITOR_PRIO) and the philosophers
+ * (RT_PHILO_PRIO) do: the monitor outranks the philosophers, so a
+ * death is seen even while every philosopher is runnable.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 if a priority is out of range.
+ */
+int	rt_configure(t_data *data)
+{
+	t_opts	*opts;
+
+	opts = &data->opts;
+	if ((opts->rt_monitor || opts->rt_philo) && !opts->rt_policy)
+		opts->rt_policy = SCHED_FIFO;
+	if (opts->rt_policy && !opts->rt_monitor && !opts->rt_philo)
+	{
+		opts->rt_monitor = RT_MONITOR_PRIO;
+		opts->rt_philo = RT_PHILO_PRIO;
+	}
+	if (!rt_valid(data, opts->rt_monitor) || !rt_valid(data, opts->rt_philo))
+		return (handle_error(ERR_RT));
+	return (0);
+}
+
+/**
+ * @brief Lock the process memory with --mlock.
+ *
+ * Called once every thread exists, so that their stacks are locked
+ * too, and so that a limited RLIMIT_MEMLOCK makes mlockall fail
+ * instead of later thread creations (which MCL_FUTURE would do).
+ * Pages are locked as they are touched where MCL_ONFAULT exists,
+ * rather than committing every thread stack up front. A refused lock
+ * only prints a warning.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	rt_lock(t_data *data)
+{
+	if (!data->opts.mlock || mlockall(RT_LOCK_FLAGS) == 0)
+		return ;
+	pthread_mutex_lock(&data->print_mutex);
+	fprintf(stderr, "rt: mlockall: %s, memory stays pageable\n",
+		strerror(errno));
+	pthread_mutex_unlock(&data->print_mutex);
+}
+
+/**
+ * @brief Move a freshly created thread to the real-time policy.
+ *
+ * Without the privilege (CAP_SYS_NICE or an RLIMIT_RTPRIO), the first
+ * refusal prints a warning and the simulation carries on with the
+ * default scheduler; later threads are not retried.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param thread The thread to promote.
+ * @param priority Its real-time priority; 0 leaves it alone.
+ */
+void	rt_promote(t_data *data, pthread_t thread, long priority)
+{
+	struct sched_param	param;
+	int					status;
+
+	if (priority == 0 || atomic_load(&data->rt_denied))
+		return ;
+	memset(&param, 0, sizeof(param));
+	param.sched_priority = priority;
+	status = pthread_setschedparam(thread, data->opts.rt_policy, &param);
+	if (status && !atomic_exchange(&data->rt_denied, true))
+	{
+		pthread_mutex_lock(&data->print_mutex);
+		fprintf(stderr, "rt: %s, running with the default scheduler\n",
+			strerror(status));
+		pthread_mutex_unlock(&data->print_mutex);
+	}
+}
@@ -6,7 +6,7 @@
 /*   By: maria-ol <maria-ol@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/09 16:38:34 by maria-ol          #+#    #+#             */
-/*   Updated: 2026/01/13 14:30:46 by maria-ol         ###   ########.fr       */
+/*   Updated: 2026/10/18 23:34:02 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -29,15 +29,39 @@ static void	*one_philo_routine(t_philo *philo)
 	return (NULL);
 }
 
+/**
+ * @brief Eat, sleep and think until the simulation ends.
+ *
+ * Introduces a small delay for even-numbered philosophers of the
+ * classic ring to reduce initial contention, and then enters an
+ * infinite loop where the philosopher repeatedly eats, sleeps, and
+ * thinks until someone dies. The loop checks the stop word before
+ * each cycle to exit gracefully, and the leaving flag set when an
+ * elastic ring removes the philosopher.
+ *
+ * @param philo Pointer to the philosopher structure.
+ */
+static void	philo_cycles(t_philo *philo)
+{
+	if (philo->id % 2 == 0 && !philo->fork_ids)
+		usleep(1000);
+	while (!simulation_over(philo->data)
+		&& !atomic_load(&philo->leaving))
+	{
+		if (!philo_eat(philo))
+			break ;
+		philo_sleep(philo);
+		philo_think(philo);
+	}
+}
+
 /**
  * @brief Main routine executed by each philosopher thread.
  *
- * This function implements the main lifecycle of a philosopher.
- * It handles the special case of a single philosopher, introduces
- * a small delay for even-numbered philosophers to reduce initial
- * contention, and then enters an infinite loop where the philosopher
- * repeatedly eats, sleeps, and thinks until someone dies. The loop
- * checks the death flag before each cycle to exit gracefully.
+ * This function implements the main lifecycle of a philosopher,
+ * handling the special case of a single philosopher. With --timetable
+ * it follows its precomputed slots instead of taking forks. With --perf,
+ * the thread's own counters are collected around it.
  *
  * @param arg Pointer to the philosopher structure cast as void*.
  * @return Always returns NULL when the routine finishes.
@@ -45,25 +69,16 @@ static void	*one_philo_routine(t_philo *philo)
 void	*philo_routine(void *arg)
 {
 	t_philo	*philo;
+	t_perf	perf;
 
 	philo = (t_philo *)arg;
-	if (philo->data->num_philos == 1)
-		return (one_philo_routine(philo));
-	if (philo->id % 2 == 0)
-		usleep(1000);
-	while (1)
-	{
-		pthread_mutex_lock(&philo->data->death_mutex);
-		if (philo->data->someone_died == true
-			|| philo->data->all_ate_enough == true)
-		{
-			pthread_mutex_unlock(&philo->data->death_mutex);
-			break ;
-		}
-		pthread_mutex_unlock(&philo->data->death_mutex);
-		philo_eat(philo);
-		philo_sleep(philo);
-		philo_think(philo);
-	}
+	perf_begin(philo->data, &perf);
+	if (philo->data->num_philos == 1 && !philo->fork_ids)
+		one_philo_routine(philo);
+	else if (philo->data->timetable_step)
+		timetable_cycles(philo);
+	else
+		philo_cycles(philo);
+	perf_end(philo->data, &perf, PERF_PHILOS);
 	return (NULL);
 }
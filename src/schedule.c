@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   schedule.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:14:37 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Create the turn mutex and condition used by replay.
+ *
+ * @param sched Pointer to the schedule.
+ * @return 0 on success, 1 on failure.
+ */
+static int	schedule_sync_init(t_schedule *sched)
+{
+	if (pthread_mutex_init(&sched->turn_mutex, NULL))
+		return (handle_error(ERR_INIT_GMUTEX));
+	if (pthread_cond_init(&sched->turn_cond, NULL))
+	{
+		pthread_mutex_destroy(&sched->turn_mutex);
+		return (handle_error(ERR_INIT_GMUTEX));
+	}
+	sched->initialized = true;
+	return (0);
+}
+
+/**
+ * @brief Initialize the schedule recorder/replayer.
+ *
+ * Sets up the turn mutex and condition used by replay, and allocates
+ * the cycle buffer when recording or replaying was requested with
+ * --record or --replay. Both options at once are rejected, since the
+ * replayed schedule would be overwritten by the new recording. The
+ * initialized flag tells schedule_destroy whether the turn mutex and
+ * condition exist.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 on failure.
+ */
+int	schedule_init(t_data *data)
+{
+	t_schedule	*sched;
+
+	sched = &data->sched;
+	sched->cycles = NULL;
+	sched->capacity = 0;
+	atomic_init(&sched->count, 0);
+	sched->pos = 0;
+	sched->recording = (data->opts.record_path != NULL);
+	sched->replaying = (data->opts.replay_path != NULL);
+	if (schedule_sync_init(sched))
+		return (1);
+	if (sched->recording && sched->replaying)
+		return (handle_error(ERR_SCHEDULE));
+	if (sched->replaying)
+		return (schedule_load(data));
+	if (!sched->recording)
+		return (0);
+	sched->capacity = SCHEDULE_CAPACITY;
+	sched->cycles = malloc(sizeof(t_cycle) * sched->capacity);
+	if (!sched->cycles)
+		return (handle_error(ERR_ALOC));
+	return (0);
+}
+
+/**
+ * @brief Release the schedule buffer and its synchronization objects.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	schedule_destroy(t_data *data)
+{
+	if (data->sched.initialized)
+	{
+		pthread_mutex_destroy(&data->sched.turn_mutex);
+		pthread_cond_destroy(&data->sched.turn_cond);
+	}
+	data->sched.initialized = false;
+	if (data->sched.cycles)
+		free(data->sched.cycles);
+	data->sched.cycles = NULL;
+}
+
+/**
+ * @brief Get the duration a phase should last.
+ *
+ * While replaying, the eat and sleep phases end at the absolute times
+ * they ended in the recorded run (grant time plus recorded durations),
+ * so the oversleep that caused a death is reproduced, but the replay's
+ * own oversleep does not add up from one phase to the next. Otherwise
+ * the configured duration is used.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @param phase PHASE_EAT or PHASE_SLEEP.
+ * @param planned The configured duration in microseconds.
+ * @return The duration to sleep in microseconds.
+ */
+long	schedule_duration(t_philo *philo, int phase, long planned)
+{
+	t_cycle	*cycle;
+	long	end;
+
+	if (!philo->data->sched.replaying || philo->cycle < 0)
+		return (planned);
+	cycle = &philo->data->sched.cycles[philo->cycle];
+	end = cycle->grant + cycle->eat;
+	if (phase == PHASE_SLEEP)
+		end += cycle->sleep;
+	end -= get_time_us() - philo->data->start_time;
+	if (end < 0)
+		return (0);
+	return (end);
+}
+
+/**
+ * @brief Record the actual duration of a finished phase.
+ *
+ * Each cycle slot is owned by the philosopher that was granted it, so
+ * no synchronization is needed to fill in the durations.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @param phase PHASE_EAT or PHASE_SLEEP.
+ * @param elapsed Measured duration of the phase in microseconds.
+ */
+void	schedule_phase(t_philo *philo, int phase, long elapsed)
+{
+	t_cycle	*cycle;
+
+	if (!philo->data->sched.recording || philo->cycle < 0)
+		return ;
+	cycle = &philo->data->sched.cycles[philo->cycle];
+	if (phase == PHASE_EAT)
+		cycle->eat = elapsed;
+	else
+		cycle->sleep = elapsed;
+}
@@ -0,0 +1,187 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   schedule_io.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:48:05 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Write the recorded schedule to the --record file.
+ *
+ * The file starts with a header line holding the philosopher count and
+ * the number of grants, followed by one line per grant:
+ * "id grant_us eat_us sleep_us". Grants beyond SCHEDULE_CAPACITY were
+ * not recorded and are dropped.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 on failure.
+ */
+int	schedule_save(t_data *data)
+{
+	FILE	*file;
+	long	count;
+	long	i;
+	t_cycle	*cycle;
+
+	if (!data->sched.recording)
+		return (0);
+	count = atomic_load(&data->sched.count);
+	if (count > data->sched.capacity)
+		count = data->sched.capacity;
+	file = fopen(data->opts.record_path, "w");
+	if (!file)
+		return (handle_error(ERR_SCHEDULE));
+	fprintf(file, "philo-schedule-us %d %ld\n", data->num_philos, count);
+	i = 0;
+	while (i < count)
+	{
+		cycle = &data->sched.cycles[i];
+		fprintf(file, "%d %ld %ld %ld\n", cycle->id, cycle->grant,
+			cycle->eat, cycle->sleep);
+		i++;
+	}
+	fclose(file);
+	return (0);
+}
+
+/**
+ * @brief Read every grant line of a schedule file.
+ *
+ * Grant times are made non-decreasing: two grants recorded at the
+ * same time may have been stored in either order. Recordings made
+ * before times were kept in microseconds hold milliseconds, and are
+ * scaled on the way in.
+ *
+ * @param file The open schedule file, positioned after the header.
+ * @param sched Pointer to the schedule receiving the grants.
+ * @param num_philos Philosopher count, used to validate the ids.
+ * @param scale Microseconds per unit of the file.
+ * @return 0 on success, 1 if a line is truncated or out of range.
+ */
+static int	read_cycles(FILE *file, t_schedule *sched, int num_philos,
+	long scale)
+{
+	long	i;
+	t_cycle	*cycle;
+
+	i = 0;
+	while (i < sched->capacity)
+	{
+		cycle = &sched->cycles[i];
+		if (fscanf(file, "%d %ld %ld %ld", &cycle->id, &cycle->grant,
+				&cycle->eat, &cycle->sleep) != 4)
+			return (1);
+		if (cycle->id < 1 || cycle->id > num_philos || cycle->grant < 0
+			|| cycle->eat < 0 || cycle->sleep < 0)
+			return (1);
+		cycle->grant *= scale;
+		cycle->eat *= scale;
+		cycle->sleep *= scale;
+		if (i > 0 && cycle->grant < cycle[-1].grant)
+			cycle->grant = cycle[-1].grant;
+		i++;
+	}
+	atomic_store(&sched->count, sched->capacity);
+	return (0);
+}
+
+/**
+ * @brief Link the loaded grants for replay.
+ *
+ * Each grant gets the index of the first grant recorded at the same
+ * time, and of the next grant of the same philosopher; each
+ * philosopher gets the index of its first grant. Walking the grants
+ * backwards, next_cycle always holds the philosopher's following one.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+static void	link_cycles(t_data *data)
+{
+	t_cycle	*cycles;
+	long	i;
+
+	cycles = data->sched.cycles;
+	i = 0;
+	while (i < data->sched.capacity)
+	{
+		cycles[i].first = i;
+		if (i > 0 && cycles[i].grant == cycles[i - 1].grant)
+			cycles[i].first = cycles[i - 1].first;
+		i++;
+	}
+	while (i-- > 0)
+	{
+		cycles[i].next = data->philos[cycles[i].id - 1].next_cycle;
+		data->philos[cycles[i].id - 1].next_cycle = i;
+	}
+}
+
+/**
+ * @brief Read the header line of a schedule file.
+ *
+ * "philo-schedule-us" files hold microseconds; plain "philo-schedule"
+ * files, written before, hold milliseconds.
+ *
+ * @param file The open schedule file.
+ * @param sched Pointer to the schedule receiving the grant count.
+ * @param num_philos Receives the philosopher count of the recording.
+ * @return Microseconds per unit of the file, 0 on a malformed header.
+ */
+static long	read_header(FILE *file, t_schedule *sched, int *num_philos)
+{
+	char	tag[24];
+
+	if (fscanf(file, "%23s %d %ld", tag, num_philos, &sched->capacity) != 3
+		|| sched->capacity < 0 || sched->capacity > SCHEDULE_CAPACITY)
+		return (0);
+	if (!strcmp(tag, "philo-schedule-us"))
+		return (1);
+	if (!strcmp(tag, "philo-schedule"))
+		return (1000);
+	return (0);
+}
+
+/**
+ * @brief Load the schedule given with --replay.
+ *
+ * The recording must come from a run with the same number of
+ * philosophers; the timing arguments are taken from the command line,
+ * while the grant times and the eat and sleep durations come from the
+ * recording. The grant count is capped at SCHEDULE_CAPACITY before
+ * anything is allocated.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 on failure.
+ */
+int	schedule_load(t_data *data)
+{
+	FILE	*file;
+	int		num_philos;
+	long	scale;
+	int		status;
+
+	file = fopen(data->opts.replay_path, "r");
+	if (!file)
+		return (handle_error(ERR_SCHEDULE));
+	status = 1;
+	scale = read_header(file, &data->sched, &num_philos);
+	if (scale && num_philos == data->num_philos)
+	{
+		data->sched.cycles = malloc(sizeof(t_cycle)
+				* (data->sched.capacity + 1));
+		if (data->sched.cycles)
+			status = read_cycles(file, &data->sched, num_philos, scale);
+	}
+	fclose(file);
+	if (status)
+		return (handle_error(ERR_SCHEDULE));
+	link_cycles(data);
+	return (0);
+}
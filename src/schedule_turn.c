@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   schedule_turn.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:31:52 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:17:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Wait until the replayed schedule grants the next forks to us.
+ *
+ * A philosopher replays its own grants in order. Each one waits until
+ * every grant recorded at an earlier time has been consumed (grants
+ * sharing a timestamp are released together), then until its recorded
+ * grant time, which is an absolute deadline from the start of the
+ * simulation so that lateness does not accumulate. simulation_stop
+ * broadcasts the turn condition and wakes the sleep, so a waiting
+ * philosopher still notices the end of the simulation. Once its grants
+ * are exhausted the philosopher waits for the whole schedule to be
+ * consumed, then runs freely again.
+ *
+ * @param philo Pointer to the philosopher structure.
+ */
+void	schedule_wait_turn(t_philo *philo)
+{
+	t_schedule	*sched;
+	t_cycle		*cycle;
+	long		released;
+	long		delay;
+
+	philo->cycle = -1;
+	sched = &philo->data->sched;
+	if (!sched->replaying)
+		return ;
+	released = atomic_load(&sched->count);
+	if (philo->next_cycle >= 0)
+		released = sched->cycles[philo->next_cycle].first;
+	pthread_mutex_lock(&sched->turn_mutex);
+	while (sched->pos < released && !simulation_over(philo->data))
+		pthread_cond_wait(&sched->turn_cond, &sched->turn_mutex);
+	pthread_mutex_unlock(&sched->turn_mutex);
+	if (philo->next_cycle < 0)
+		return ;
+	cycle = &sched->cycles[philo->next_cycle];
+	philo->cycle = philo->next_cycle;
+	philo->next_cycle = cycle->next;
+	delay = philo->data->start_time + cycle->grant - get_time_us();
+	if (delay > 0)
+		precise_sleep(delay, philo->data);
+}
+
+/**
+ * @brief Note that a philosopher has been granted both forks.
+ *
+ * When recording, this claims the next cycle slot with a single atomic
+ * increment, which is the only cost added to the fork path. When
+ * replaying, it counts the grant as consumed and wakes the
+ * philosophers whose grants come next.
+ *
+ * @param philo Pointer to the philosopher structure.
+ */
+void	schedule_grant(t_philo *philo)
+{
+	t_schedule	*sched;
+	long		slot;
+
+	sched = &philo->data->sched;
+	if (sched->recording)
+	{
+		slot = atomic_fetch_add(&sched->count, 1);
+		philo->cycle = -1;
+		if (slot >= sched->capacity)
+			return ;
+		philo->cycle = slot;
+		sched->cycles[slot].id = philo->id;
+		sched->cycles[slot].grant = get_time_us() - philo->data->start_time;
+		sched->cycles[slot].eat = 0;
+		sched->cycles[slot].sleep = 0;
+	}
+	else if (sched->replaying && philo->cycle >= 0)
+	{
+		pthread_mutex_lock(&sched->turn_mutex);
+		sched->pos++;
+		pthread_cond_broadcast(&sched->turn_cond);
+		pthread_mutex_unlock(&sched->turn_mutex);
+	}
+}
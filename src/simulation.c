@@ -0,0 +1,183 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   simulation.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maria-ol <maria-ol@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:40:26 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:38:40 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Initialize synchronized meal timestamps for all philosophers.
+ *
+ * This function performs a critical synchronized initialization by
+ * setting the simulation start time and initializing all philosophers'
+ * last_meal_time to this exact timestamp. This ensures all philosophers
+ * begin with the same time reference, preventing race conditions where
+ * the monitor could detect false deaths if timestamps were initialized
+ * individually by each thread. The meal_mutex protects this atomic
+ * operation, guaranteeing all timestamps are set before any philosopher
+ * thread starts checking for starvation. A --nodes process keeps the
+ * start time the coordinator chose before forking it. The
+ * eating-concurrency tracker is reset against this start time.
+ *
+ * @param data Pointer to the shared data structure containing all
+ *             simulation parameters and philosopher information.
+ * @return 0 on success.
+ */
+static int	meal_simulation(t_data *data)
+{
+	int			i;
+
+	if (data->node.index < 0)
+		data->start_time = get_time_us();
+	pthread_mutex_lock(&data->meal_mutex);
+	i = 0;
+	while (i < data->num_philos)
+	{
+		data->philos[i].last_meal_time = data->start_time;
+		i++;
+	}
+	pthread_mutex_unlock(&data->meal_mutex);
+	eating_start(data);
+	return (0);
+}
+
+/**
+ * @brief Start a thread for every seated philosopher.
+ *
+ * Seats that start empty (spare elastic seats, or the segments run by
+ * other --nodes processes) get no thread.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 if a thread could not be created.
+ */
+static int	create_philos(t_data *data)
+{
+	int	i;
+
+	i = 0;
+	while (i < data->num_philos)
+	{
+		if (atomic_load(&data->philos[i].active))
+		{
+			if (pthread_create(&data->philos[i].thread, NULL,
+					philo_routine, &data->philos[i]))
+				return (handle_error(ERR_PHILO_THREAD));
+			rt_promote(data, data->philos[i].thread, data->opts.rt_philo);
+			data->philos[i].joinable = true;
+		}
+		i++;
+	}
+	return (0);
+}
+
+/**
+ * @brief Wait for every philosopher thread still running.
+ *
+ * The elastic control thread is joined first, since it may start or
+ * reap philosopher threads until the simulation stops. The time at
+ * which the last philosopher was joined is kept for the --stats report.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+static void	join_philos(t_data *data)
+{
+	int	i;
+
+	elastic_join(data);
+	i = 0;
+	while (i < data->num_seats)
+	{
+		if (data->philos[i].joinable)
+			pthread_join(data->philos[i].thread, NULL);
+		data->philos[i].joinable = false;
+		i++;
+	}
+	data->joined_time = get_time_us();
+}
+
+/**
+ * @brief Start the philosophers simulation.
+ *
+ * This function initializes the simulation start time, creates a
+ * thread for each philosopher, and creates a monitor thread to check
+ * for death or completion conditions. It then waits for all threads
+ * to finish before returning. Each philosopher's last_meal_time is
+ * initialized to the simulation start time. With --control, the
+ * control thread that adds and removes seats is started as well. With
+ * --nodes, the coordinator forks the node processes instead, and each
+ * node runs this function for its own segment only. With --rt, the
+ * main thread is promoted first so that a loaded CPU cannot delay the
+ * creation of the philosophers past their first deadline. Short phases
+ * get a tight timer slack, which the philosophers inherit.
+ *
+ * @param data Pointer to the shared data structure containing all
+ *             simulation parameters and philosopher information.
+ * @return 0 on success, 1 on failure.
+ */
+int	start_simulation(t_data *data)
+{
+	int			status;
+	pthread_t	monitor;
+
+	if (data->node.count && data->node.index < 0)
+		return (nodes_start(data));
+	rt_promote(data, pthread_self(), data->opts.rt_philo);
+	timer_tighten(data);
+	meal_simulation(data);
+	if (create_philos(data))
+		return (1);
+	if (pthread_create(&monitor, NULL, monitor_routine, data))
+		return (handle_error(ERR_MONIT_THREAD));
+	rt_promote(data, monitor, data->opts.rt_monitor);
+	rt_lock(data);
+	status = (elastic_start(data) || node_start(data)
+			|| detect_start(data));
+	if (status)
+		simulation_stop(data);
+	join_philos(data);
+	pthread_join(monitor, NULL);
+	detect_join(data);
+	node_join(data);
+	stats_report(data);
+	perf_report(data);
+	return (status);
+}
+
+/**
+ * @brief Set up, run and tear down one simulation.
+ *
+ * Initializes the global mutexes, the optional conflict graph, elastic
+ * ring, nodes and fork bitmap, the forks, philosophers and the schedule
+ * recorder, then starts the simulation. All resources are cleaned up
+ * before returning, regardless of success or failure. The capacity
+ * planner runs each of its trials through here.
+ *
+ * @param data Pointer to the data structure filled by init_data.
+ * @return 0 on success, 1 on failure.
+ */
+int	run_simulation(t_data *data)
+{
+	if (init_mutexes(data) || topology_load(data)
+		|| elastic_configure(data) || nodes_configure(data)
+		|| bitmap_configure(data) || rt_configure(data)
+		|| perf_configure(data) || timetable_configure(data)
+		|| init_forks(data) || init_philos(data) || schedule_init(data))
+	{
+		cleanup(data);
+		return (1);
+	}
+	if (start_simulation(data) || schedule_save(data))
+	{
+		cleanup(data);
+		return (1);
+	}
+	cleanup(data);
+	return (0);
+}
@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:05:12 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:27:58 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include "probes.h"
+
+/**
+ * @brief Reset the run statistics.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	stats_init(t_data *data)
+{
+	int	i;
+
+	data->stop_time = 0;
+	data->joined_time = 0;
+	data->meals_total = 0;
+	data->min_slack = data->time_to_die;
+	atomic_init(&data->wait_max, 0);
+	i = 0;
+	while (i < WAIT_BUCKETS)
+	{
+		atomic_init(&data->wait_hist[i], 0);
+		i++;
+	}
+}
+
+/**
+ * @brief Account for the time a philosopher waited for its forks.
+ *
+ * Waits are counted in power-of-two buckets of microseconds, so the
+ * tail can be read back without keeping every sample. Lock-free, as it
+ * runs on every meal.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param wait_us Time from starting to take the forks to holding them.
+ */
+static void	stats_wait(t_data *data, long wait_us)
+{
+	long	max;
+	int		bucket;
+
+	bucket = 0;
+	while (bucket < WAIT_BUCKETS - 1 && (wait_us >> (bucket + 1)) > 0)
+		bucket++;
+	atomic_fetch_add(&data->wait_hist[bucket], 1);
+	max = atomic_load(&data->wait_max);
+	while (wait_us > max)
+	{
+		if (atomic_compare_exchange_weak(&data->wait_max, &max, wait_us))
+			break ;
+	}
+}
+
+/**
+ * @brief Upper bound of the bucket holding a given share of the waits.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param permille Share of the waits, in thousandths (990 for p99).
+ * @return Wait time in us that permille of the waits did not exceed.
+ */
+static long	wait_percentile(t_data *data, long permille)
+{
+	long	total;
+	long	seen;
+	int		i;
+
+	total = 0;
+	i = 0;
+	while (i < WAIT_BUCKETS)
+	{
+		total += atomic_load(&data->wait_hist[i]);
+		i++;
+	}
+	seen = 0;
+	i = 0;
+	while (i < WAIT_BUCKETS - 1)
+	{
+		seen += atomic_load(&data->wait_hist[i]);
+		if (seen * 1000 >= total * permille)
+			break ;
+		i++;
+	}
+	return ((2L << i) - 1);
+}
+
+/**
+ * @brief Account for a philosopher that just got its forks.
+ *
+ * Records the fork wait and the start of a meal for --stats, resets
+ * the miss counter the livelock detector watches, and fires the
+ * forks_granted probe.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @param wait_start Time at which the philosopher started to take its
+ *                   forks, in microseconds.
+ */
+void	stats_forks_taken(t_philo *philo, long wait_start)
+{
+	if (philo->data->opts.stats)
+		stats_wait(philo->data, get_time_us() - wait_start);
+	eating_change(philo->data, 1);
+	atomic_store_explicit(&philo->misses, 0, memory_order_relaxed);
+	PROBE3(forks_granted, philo->id, wait_start, get_time_us());
+}
+
+/**
+ * @brief Print run statistics to stderr when --stats is given.
+ *
+ * The simulation log on stdout is left untouched so that it can still
+ * be checked line by line. Reported values:
+ * - meals, meals_per_sec: total meals eaten and overall throughput.
+ * - min_slack_ms: smallest margin before time_to_die seen by the
+ *   monitor (negative once someone died), with three decimals when
+ *   it is not a whole number of milliseconds.
+ * - wait_p50_us, wait_p99_us, wait_max_us: time from starting to take
+ *   the forks to holding them; percentiles are bucket upper bounds.
+ * - teardown_us: time from simulation_stop until every philosopher
+ *   thread has been joined.
+ * With --nodes only the coordinator reports, summing the meals of all
+ * nodes. min_slack_ms is replaced by nodes and detect_us, the time a
+ * death took to reach the coordinator (-1 without a death), and
+ * teardown_us runs until the last node process is gone.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	stats_report(t_data *data)
+{
+	long	elapsed;
+
+	if (!data->opts.stats || data->node.index >= 0)
+		return ;
+	elapsed = data->stop_time - data->start_time;
+	if (elapsed < 1)
+		elapsed = 1;
+	fprintf(stderr, "meals %ld\n", data->meals_total);
+	fprintf(stderr, "meals_per_sec %ld\n",
+		data->meals_total * 1000000 / elapsed);
+	if (data->node.count)
+		fprintf(stderr, "nodes %d\ndetect_us %ld\n", data->node.count,
+			data->node.detect_us);
+	else
+	{
+		print_ms(stderr, "min_slack_ms ", data->min_slack, "\n");
+		fprintf(stderr, "wait_p50_us %ld\nwait_p99_us %ld\nwait_max_us %ld\n",
+			wait_percentile(data, 500), wait_percentile(data, 990),
+			atomic_load(&data->wait_max));
+		eating_report(data);
+	}
+	fprintf(stderr, "teardown_us %ld\n", data->joined_time - data->stop_time);
+}
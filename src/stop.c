@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stop.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 12:52:40 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 22:58:56 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Check whether the simulation has ended.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return true once simulation_stop has been called, false otherwise.
+ */
+bool	simulation_over(t_data *data)
+{
+	return (atomic_load(&data->stop) != 0);
+}
+
+/**
+ * @brief Wake every philosopher blocked on a fork.
+ *
+ * This scans every fork, but only forks with registered waiters are
+ * written to or cost a system call; the scan itself is one load per
+ * fork, far below the cost of joining the threads that follows.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+static void	forks_wake_all(t_data *data)
+{
+	int	i;
+
+	i = 0;
+	while (i < data->num_forks)
+	{
+		if (atomic_load(&data->forks[i].waiters) > 0)
+		{
+			atomic_fetch_add(&data->forks[i].gen, 1);
+			futex_wake(&data->forks[i].gen, INT_MAX_VALUE);
+		}
+		i++;
+	}
+}
+
+/**
+ * @brief Stop the simulation and wake every blocked thread at once.
+ *
+ * Called by the monitor right after it sets someone_died or
+ * all_ate_enough. Sleepers in precise_sleep wait on the stop word and
+ * are released by a single broadcast; fork waiters (on a fork, or on
+ * their own futex with --forks=bitmap), philosophers waiting for
+ * their replay turn or for a fork lent by another node, and the
+ * elastic control thread are woken explicitly. Teardown time
+ * therefore no longer depends on the sleep polling interval or on how
+ * long fork holders keep eating.
+ *
+ * @param data Pointer to the shared data structure.
+ */
+void	simulation_stop(t_data *data)
+{
+	data->stop_time = get_time_us();
+	atomic_store(&data->stop, 1);
+	futex_wake(&data->stop, INT_MAX_VALUE);
+	if (data->forks)
+		forks_wake_all(data);
+	if (data->fork_bits && data->philos)
+		bitmap_wake_all(data);
+	if (data->control.wake[1] >= 0)
+		write(data->control.wake[1], "", 1);
+	atomic_fetch_add(&data->node.client.gen, 1);
+	futex_wake(&data->node.client.gen, INT_MAX_VALUE);
+	if (!data->sched.initialized)
+		return ;
+	pthread_mutex_lock(&data->sched.turn_mutex);
+	pthread_cond_broadcast(&data->sched.turn_cond);
+	pthread_mutex_unlock(&data->sched.turn_mutex);
+}
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timetable.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 23:59:55 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:59:55 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+#include "probes.h"
+
+/**
+ * @brief Check that the ring fits a static timetable and size its step.
+ *
+ * Time is cut into steps of max(time_to_eat, (eat + sleep) / 2). At
+ * step t, seat p eats when d = (p - t) mod N is even and below
+ * 2 * floor(N/2): the two alternating phases of an even ring, and for
+ * an odd one a pattern that rotates by one seat each step, so that a
+ * philosopher eats every other step but once every N steps waits for
+ * three. No two neighbors ever share a step, and each one has finished
+ * its nap before its next slot. The longest gap between two meal starts
+ * (2 or 3 steps) must stay below time_to_die; the predicted slack is
+ * printed on stderr before the run starts.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success (or without --timetable), 1 if the ring does not
+ *         qualify or would starve.
+ */
+int	timetable_configure(t_data *data)
+{
+	long	step;
+	long	gap;
+
+	data->timetable_step = 0;
+	if (!data->opts.timetable)
+		return (0);
+	if (data->num_philos < 2 || data->topo_forks || data->elastic
+		|| data->node.count || data->fork_bits
+		|| data->opts.record_path || data->opts.replay_path)
+		return (handle_error(ERR_TIMETABLE));
+	step = data->time_to_eat;
+	if ((data->time_to_eat + data->time_to_sleep + 1) / 2 > step)
+		step = (data->time_to_eat + data->time_to_sleep + 1) / 2;
+	gap = step * (2 + data->num_philos % 2);
+	print_ms(stderr, "timetable_step_ms ", step, "\n");
+	print_ms(stderr, "timetable_gap_ms ", gap, "\n");
+	print_ms(stderr, "timetable_slack_ms ", data->time_to_die - gap, "\n");
+	if (gap >= data->time_to_die)
+		return (handle_error(ERR_TIMETABLE_SLACK));
+	data->timetable_step = step;
+	return (0);
+}
+
+/**
+ * @brief Find the first step, from a given one, at which a seat eats.
+ *
+ * @param data Pointer to the shared data structure.
+ * @param seat Index of the seat, from 0.
+ * @param step First step to consider.
+ * @return The step of the seat's next meal, at most three steps later.
+ */
+static long	timetable_next(t_data *data, int seat, long step)
+{
+	long	n;
+	long	d;
+
+	n = data->num_philos;
+	while (1)
+	{
+		d = ((seat - step) % n + n) % n;
+		if (d % 2 == 0 && d < n / 2 * 2)
+			return (step);
+		step++;
+	}
+}
+
+/**
+ * @brief Eat in the slot starting at a given time.
+ *
+ * The slot guarantees that both neighbors are away from the table, so
+ * no fork is locked; the fork lines are printed for the log format
+ * only. For --stats, the fork wait is the lateness of the thread
+ * against its slot.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @param slot Start of the slot, in microseconds.
+ */
+static void	timetable_meal(t_philo *philo, long slot)
+{
+	long	start;
+
+	print_status(philo, "has taken a fork");
+	print_status(philo, "has taken a fork");
+	stats_forks_taken(philo, slot);
+	print_status(philo, "is eating");
+	start = get_time_us();
+	pthread_mutex_lock(&philo->data->meal_mutex);
+	philo->last_meal_time = start;
+	philo->meals_eaten++;
+	philo->data->meals_total++;
+	pthread_mutex_unlock(&philo->data->meal_mutex);
+	PROBE3(eat_start, philo->id, philo->meals_eaten, start);
+	precise_sleep(slot + philo->data->time_to_eat - get_time_us(),
+		philo->data);
+	PROBE3(eat_end, philo->id, philo->meals_eaten, get_time_us());
+	eating_change(philo->data, -1);
+}
+
+/**
+ * @brief Follow the static timetable until the simulation ends.
+ *
+ * Every sleep runs to an absolute deadline computed from the slot,
+ * not from the time the thread woke up, so lateness never builds up
+ * from one cycle to the next.
+ *
+ * @param philo Pointer to the philosopher structure.
+ */
+void	timetable_cycles(t_philo *philo)
+{
+	t_data	*data;
+	long	step;
+	long	slot;
+
+	data = philo->data;
+	step = 0;
+	while (!simulation_over(data))
+	{
+		step = timetable_next(data, philo->id - 1, step);
+		slot = data->start_time + step * data->timetable_step;
+		precise_sleep(slot - get_time_us(), data);
+		if (simulation_over(data))
+			break ;
+		timetable_meal(philo, slot);
+		print_status(philo, "is sleeping");
+		PROBE2(sleep, philo->id, get_time_us());
+		precise_sleep(slot + data->time_to_eat + data->time_to_sleep
+			- get_time_us(), data);
+		print_status(philo, "is thinking");
+		PROBE2(think, philo->id, get_time_us());
+		step++;
+	}
+}
@@ -0,0 +1,183 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 11:20:44 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 22:41:55 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Read the "philosophers forks" header of a topology file.
+ *
+ * @param file The open topology file.
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 if the header is malformed or the
+ *         philosopher count differs from the command line.
+ */
+static int	read_header(FILE *file, t_data *data)
+{
+	int	num_philos;
+
+	if (fscanf(file, "%d %d", &num_philos, &data->num_forks) != 2)
+		return (1);
+	if (num_philos != data->num_philos || data->num_forks < 1)
+		return (1);
+	return (0);
+}
+
+/**
+ * @brief First pass: count how many forks each philosopher needs.
+ *
+ * Builds the CSR row offsets from the per-philosopher degrees. The
+ * last offset is the total number of (philosopher, fork) pairs. A
+ * philosopher
+ * that shares no fork at all is rejected: it could eat without ever
+ * waiting, which is not a dining table.
+ *
+ * @param file The open topology file, positioned after the header.
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 on malformed input or allocation failure.
+ */
+static int	count_degrees(FILE *file, t_data *data)
+{
+	int	fork;
+	int	members;
+	int	philo;
+
+	fork = 0;
+	while (fork++ < data->num_forks)
+	{
+		if (fscanf(file, "%d", &members) != 1 || members < 0)
+			return (1);
+		while (members-- > 0)
+		{
+			if (fscanf(file, "%d", &philo) != 1
+				|| philo < 1 || philo > data->num_philos)
+				return (1);
+			data->topo_offsets[philo]++;
+		}
+	}
+	philo = 0;
+	while (philo++ < data->num_philos)
+	{
+		if (data->topo_offsets[philo] == 0)
+			return (1);
+		data->topo_offsets[philo] += data->topo_offsets[philo - 1];
+	}
+	return (0);
+}
+
+/**
+ * @brief Second pass: store each fork in the rows of its philosophers.
+ *
+ * Forks are visited in increasing index order, so every row ends up
+ * sorted, which is the acquisition order used to avoid deadlock. A
+ * philosopher listed twice for the same fork is rejected. The file's
+ * own fork-major rows are kept too (fork_offsets, fork_philos), so a
+ * philosopher can find everyone it shares a fork with.
+ *
+ * @param file The open topology file, positioned after the header.
+ * @param data Pointer to the shared data structure.
+ * @param cursor Per-philosopher write position, starting at the offsets.
+ * @return 0 on success, 1 on malformed input.
+ */
+static int	fill_forks(FILE *file, t_data *data, int *cursor)
+{
+	int	fork;
+	int	members;
+	int	philo;
+
+	fork = 0;
+	data->fork_offsets[0] = 0;
+	while (fork < data->num_forks)
+	{
+		if (fscanf(file, "%d", &members) != 1)
+			return (1);
+		data->fork_offsets[fork + 1] = data->fork_offsets[fork];
+		while (members-- > 0)
+		{
+			if (fscanf(file, "%d", &philo) != 1)
+				return (1);
+			philo--;
+			if (cursor[philo] > data->topo_offsets[philo]
+				&& data->topo_forks[cursor[philo] - 1] == fork)
+				return (1);
+			data->topo_forks[cursor[philo]++] = fork;
+			data->fork_philos[data->fork_offsets[fork + 1]++] = philo;
+		}
+		fork++;
+	}
+	return (0);
+}
+
+/**
+ * @brief Run both passes over an open topology file.
+ *
+ * The arrays are sized from the first pass: one entry per
+ * (philosopher, fork) pair in each direction, plus the fork offsets.
+ *
+ * @param file The open topology file.
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success, 1 on malformed input or allocation failure.
+ */
+static int	read_graph(FILE *file, t_data *data)
+{
+	int	*cursor;
+	int	pairs;
+	int	status;
+
+	data->topo_offsets = calloc(data->num_philos + 1, sizeof(int));
+	if (!data->topo_offsets || read_header(file, data)
+		|| count_degrees(file, data))
+		return (1);
+	pairs = data->topo_offsets[data->num_philos];
+	data->topo_forks = malloc(sizeof(int) * pairs);
+	data->fork_philos = malloc(sizeof(int) * pairs);
+	data->fork_offsets = malloc(sizeof(int) * (data->num_forks + 1));
+	cursor = malloc(sizeof(int) * data->num_philos);
+	status = (!data->topo_forks || !data->fork_philos
+			|| !data->fork_offsets || !cursor);
+	if (!status)
+	{
+		memcpy(cursor, data->topo_offsets, sizeof(int) * data->num_philos);
+		rewind(file);
+		status = (read_header(file, data) || fill_forks(file, data, cursor));
+	}
+	free(cursor);
+	return (status);
+}
+
+/**
+ * @brief Load the conflict graph given with --topology.
+ *
+ * The file holds "philosophers forks" followed by one line per fork
+ * (a hyperedge): the number of philosophers sharing it, then their
+ * 1-based ids. An ordinary edge is a fork shared by two philosophers.
+ * The graph is inverted into CSR form, philosopher -> sorted fork
+ * indices, in two streaming passes over the file.
+ *
+ * @param data Pointer to the shared data structure.
+ * @return 0 on success (or without --topology), 1 on failure.
+ */
+int	topology_load(t_data *data)
+{
+	FILE	*file;
+	int		status;
+
+	if (!data->opts.topology_path)
+		return (0);
+	file = fopen(data->opts.topology_path, "r");
+	if (!file)
+		return (handle_error(ERR_TOPOLOGY));
+	status = read_graph(file, data);
+	fclose(file);
+	if (status)
+		return (handle_error(ERR_TOPOLOGY));
+	return (0);
+}
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology_forks.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 11:47:09 by mona              #+#    #+#             */
+/*   Updated: 2026/10/18 23:05:05 by mona             ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philosophers.h"
+
+/**
+ * @brief Take every fork a philosopher needs on the conflict graph.
+ *
+ * Forks are locked in increasing global index order (each CSR row is
+ * sorted), so no cycle of philosophers can each hold a fork the next
+ * one waits for, whatever the shape of the graph. If the simulation
+ * stops while waiting, the forks already taken are given back. In an
+ * elastic ring the seat mutex is held until the forks are released,
+ * so the fork pair cannot be switched in the middle of a meal.
+ *
+ * @param philo Pointer to the philosopher structure.
+ * @return true if all forks were taken, false if the simulation stopped.
+ */
+bool	take_graph_forks(t_philo *philo)
+{
+	int	i;
+
+	if (philo->data->elastic)
+		pthread_mutex_lock(&philo->seat_mutex);
+	i = 0;
+	while (i < philo->num_forks)
+	{
+		if (!fork_lock(philo->data, &philo->data->forks[philo->fork_ids[i]],
+				philo->id - 1))
+		{
+			while (i-- > 0)
+				fork_unlock(&philo->data->forks[philo->fork_ids[i]]);
+			if (philo->data->elastic)
+				pthread_mutex_unlock(&philo->seat_mutex);
+			return (false);
+		}
+		print_status(philo, "has taken a fork");
+		i++;
+	}
+	return (true);
+}
+
+/**
+ * @brief Release the conflict-graph forks in reverse order.
+ *
+ * In an elastic ring this also releases the seat mutex.
+ *
+ * @param philo Pointer to the philosopher structure.
+ */
+void	release_graph_forks(t_philo *philo)
+{
+	int	i;
+
+	i = philo->num_forks;
+	while (i > 0)
+	{
+		i--;
+		fork_unlock(&philo->data->forks[philo->fork_ids[i]]);
+	}
+	if (philo->data->elastic)
+		pthread_mutex_unlock(&philo->seat_mutex);
+}
+
+/**
+ * @brief Point a philosopher at its forks.
+ *
+ * Without a topology the philosopher gets the classic left/right ring
+ * forks and fork_ids stays NULL. With one, it gets its row of the
+ * conflict graph and no ring forks, whose indices may not even exist.
+ *
+ * @param philo Pointer to the philosopher structure, id already set.
+ */
+void	topology_assign(t_philo *philo)
+{
+	t_data	*data;
+	int		row;
+
+	data = philo->data;
+	row = philo->id - 1;
+	philo->fork_ids = NULL;
+	philo->num_forks = 2;
+	philo->left_fork = NULL;
+	philo->right_fork = NULL;
+	if (!data->topo_forks)
+	{
+		philo->left_fork = &data->forks[row];
+		philo->right_fork = &data->forks[(row + 1) % data->num_seats];
+		return ;
+	}
+	philo->fork_ids = &data->topo_forks[data->topo_offsets[row]];
+	philo->num_forks = data->topo_offsets[row + 1] - data->topo_offsets[row];
+}
@@ -6,107 +6,93 @@
 /*   By: mona <mona@student.42.fr>                  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/01/07 13:47:13 by mona              #+#    #+#             */
-/*   Updated: 2026/01/12 19:50:43 by mona             ###   ########.fr       */
+/*   Updated: 2026/10/18 23:34:02 by mona             ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philosophers.h"
+#include "probes.h"
 
 /**
- * @brief Get current time in milliseconds.
+ * @brief Get current time in microseconds.
  *
- * This function retrieves the current time using gettimeofday and
- * converts it to milliseconds. The returned value represents the
- * number of milliseconds since the Unix epoch (January 1, 1970).
+ * This function retrieves the current time using gettimeofday. The
+ * returned value is the number of microseconds since the Unix epoch
+ * (January 1, 1970); it is the single clock of the simulation.
  *
- * @return Current time in milliseconds as a long integer.
+ * @return Current time in microseconds as a long integer.
  */
-long	get_time(void)
+long	get_time_us(void)
 {
 	struct timeval	tv;
 
 	gettimeofday(&tv, NULL);
-	return ((tv.tv_sec * 1000 + tv.tv_usec / 1000));
+	return (tv.tv_sec * 1000000L + tv.tv_usec);
 }
 
 /**
- * @brief Precise sleep with death check.
+ * @brief Precise sleep that ends early when the simulation stops.
  *
- * This function implements a precise sleep mechanism that continuously
- * checks if any philosopher has died during the sleep period. It uses
- * small intervals of usleep (500 microseconds) to maintain
- * responsiveness while sleeping for the specified duration. The
- * function will exit early if someone_died flag is set to true.
+ * This function sleeps until an absolute deadline by waiting on the
+ * simulation's stop word with a timeout. The wait is cut short by the
+ * broadcast in simulation_stop, so a sleeping philosopher notices the
+ * end of the simulation immediately instead of on its next polling
+ * interval.
  *
- * @param milliseconds The duration to sleep in milliseconds.
- * @param data Pointer to the shared data structure containing
- *             death_mutex and someone_died flag.
+ * @param microseconds The duration to sleep in microseconds.
+ * @param data Pointer to the shared data structure containing the
+ *             stop word.
  */
-void	precise_sleep(long milliseconds, t_data *data)
+void	precise_sleep(long microseconds, t_data *data)
 {
-	long	start;
-	long	current;
+	long	deadline;
+	long	remaining;
 
-	start = get_time();
-	while (1)
+	deadline = get_time_us() + microseconds;
+	while (!atomic_load(&data->stop))
 	{
-		pthread_mutex_lock(&data->death_mutex);
-		if (data->someone_died)
-		{
-			pthread_mutex_unlock(&data->death_mutex);
+		remaining = deadline - get_time_us();
+		if (remaining <= 0)
 			break ;
-		}
-		pthread_mutex_unlock(&data->death_mutex);
-		current = get_time();
-		if (current - start >= milliseconds)
-			break ;
-		usleep(SLEEP_CHECK_INTERVAL);
+		futex_wait(&data->stop, 0, remaining);
 	}
 }
 
 /**
- * @brief Handle and display error messages.
+ * @brief Print a duration in milliseconds.
  *
- * This function takes an error code from the t_error enum and displays
- * the corresponding error message to the standard output. It uses a
- * static array of error messages indexed by the error code. The
- * function always returns 1 to indicate an error occurred.
+ * Whole milliseconds are printed as a plain integer, as they always
+ * were; anything finer gets three decimals ("0.250").
  *
- * @param error The error code from the t_error enum indicating the
- *              type of error.
- * @return Always returns 1 to indicate an error condition.
+ * @param out The stream to print to.
+ * @param before Text printed before the value.
+ * @param us The duration in microseconds, possibly negative.
+ * @param after Text printed after the value.
  */
-int	handle_error(t_error error)
+void	print_ms(FILE *out, char *before, long us, char *after)
 {
-	static const char	*messages[] = {
-		NULL,
-		"Error\nInvalid number of arguments\n",
-		"Error\nArgument must be numeric only\n",
-		"Error\nArgument must be a positive integer\n",
-		"Error\nValue exceeds maximum (2147483647)\n",
-		"Error\nOne philosopher cannot eat (needs at least 2)\n",
-		"Error\nFailed to initialize global mutex\n",
-		"Error\nFailed to initialize fork mutex\n",
-		"Error\nMemory allocation failed\n",
-		"Error\nFailed to create philosopher thread\n",
-		"Error\nFailed to create monitor thread\n"
-	};
-
-	if (error > 0 && error < (int)(sizeof(messages) / sizeof(messages[0])))
+	fprintf(out, "%s", before);
+	if (us < 0)
 	{
-		printf("%s", messages[error]);
+		fprintf(out, "-");
+		us = -us;
 	}
-	return (1);
+	if (us % 1000 == 0)
+		fprintf(out, "%ld%s", us / 1000, after);
+	else
+		fprintf(out, "%ld.%03ld%s", us / 1000, us % 1000, after);
 }
 
 /**
  * @brief Print philosopher status in a thread-safe manner.
  *
  * This function prints the current status of a philosopher with a
- * timestamp relative to the simulation start time. It ensures
+ * timestamp in milliseconds relative to the simulation start time. It ensures
  * thread-safety by using mutexes to protect both the death check
  * and the printing operation. If someone has already died, the
  * function returns without printing to avoid output after death.
+ * In a --nodes process the line is sent to the coordinator, which
+ * prints the log of all the nodes.
  *
  * @param philo Pointer to the philosopher structure whose status is
  *              being printed.
@@ -126,7 +112,12 @@ void	print_status(t_philo *philo, char *status)
 	}
 	pthread_mutex_unlock(&philo->data->death_mutex);
 	pthread_mutex_lock(&philo->data->print_mutex);
-	timestamp = get_time() - philo->data->start_time;
-	printf("%ld %d %s\n", timestamp, philo->id, status);
+	timestamp = (get_time_us() - philo->data->start_time) / 1000;
+	PROBE3(status, philo->id, timestamp, status);
+	if (philo->data->node.index >= 0)
+		node_print(philo->data, philo->id, status, timestamp);
+	else
+		printf("%ld %d %s\n", timestamp, philo->id, status);
 	pthread_mutex_unlock(&philo->data->print_mutex);
 }
+